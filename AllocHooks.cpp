@@ -0,0 +1,37 @@
+// 全局分配钩子：重载operator new/delete，把每次分配记入AllocTracker（每块前置16字节记录大小）。
+// 不属于MazeCore库，由需要统计的程序直接编译进来（基准程序始终链接；游戏和模拟程序由CMake选项MAZE_ALLOC_TRACKING控制）
+#include "AllocTracker.h"
+#include <cstdlib>
+#include <new>
+
+namespace {
+    const bool registered = (AllocTracker::markHooked(), true);
+}
+
+void* operator new(size_t size) {
+    void* block = std::malloc(size + 16);
+    if (block == nullptr) throw std::bad_alloc();
+    *static_cast<size_t*>(block) = size;
+    AllocTracker::onAlloc(size);
+    return static_cast<char*>(block) + 16;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    try { return operator new(size); }
+    catch (...) { return nullptr; }
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    try { return operator new(size); }
+    catch (...) { return nullptr; }
+}
+void operator delete(void* ptr) noexcept {
+    if (ptr == nullptr) return;
+    char* block = static_cast<char*>(ptr) - 16;
+    AllocTracker::onFree(*reinterpret_cast<size_t*>(block));
+    std::free(block);
+}
+void operator delete[](void* ptr) noexcept { operator delete(ptr); }
+void operator delete(void* ptr, size_t) noexcept { operator delete(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { operator delete(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { operator delete(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { operator delete(ptr); }
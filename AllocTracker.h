@@ -0,0 +1,91 @@
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// 内存统计：由AllocHooks.cpp中重载的全局operator new/delete更新（只有链接了该文件的程序才有数据），
+// 记录全进程的当前与峰值堆占用，以及各线程自己的累计分配次数和字节数
+class AllocTracker {
+public:
+    static void onAlloc(size_t bytes) {
+        size_t now = current().fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        size_t prev = peak().load(std::memory_order_relaxed);
+        while (now > prev && !peak().compare_exchange_weak(prev, now, std::memory_order_relaxed)) {
+        }
+        allocations().fetch_add(1, std::memory_order_relaxed);
+        ThreadCounts& counts = threadCounts();
+        ++counts.allocations;
+        counts.bytes += bytes;
+    }
+    static void onFree(size_t bytes) {
+        current().fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    // 分配钩子是否已链接（钩子文件在静态初始化时置位）
+    static bool isHooked() { return hooked().load(std::memory_order_relaxed); }
+    static void markHooked() { hooked().store(true, std::memory_order_relaxed); }
+
+    static size_t currentBytes() { return current().load(std::memory_order_relaxed); }
+    static size_t peakBytes() { return peak().load(std::memory_order_relaxed); }
+    static size_t allocationCount() { return allocations().load(std::memory_order_relaxed); }
+    // 把峰值重置为当前占用（每个用例开始前调用）
+    static void resetPeak() { peak().store(currentBytes(), std::memory_order_relaxed); }
+
+    // 当前线程的累计分配次数/字节数（不含其他线程，工作线程的分配不计入主循环的帧统计）
+    static uint64_t threadAllocationCount() { return threadCounts().allocations; }
+    static uint64_t threadAllocatedBytes() { return threadCounts().bytes; }
+
+private:
+    // 平凡类型的thread_local不需要动态初始化，可在operator new中安全使用
+    struct ThreadCounts {
+        uint64_t allocations;
+        uint64_t bytes;
+    };
+
+    static std::atomic<size_t>& current() { static std::atomic<size_t> value(0); return value; }
+    static std::atomic<size_t>& peak() { static std::atomic<size_t> value(0); return value; }
+    static std::atomic<size_t>& allocations() { static std::atomic<size_t> value(0); return value; }
+    static std::atomic<bool>& hooked() { static std::atomic<bool> value(false); return value; }
+    static ThreadCounts& threadCounts() { static thread_local ThreadCounts value = { 0, 0 }; return value; }
+};
+
+// 逐帧分配统计：主循环每帧开头调用beginFrame，结算上一帧本线程的分配（未链接钩子时全为0）
+class FrameAllocCounter {
+public:
+    FrameAllocCounter()
+        : frameStartCount(AllocTracker::threadAllocationCount()), frameStartBytes(AllocTracker::threadAllocatedBytes()),
+        lastAllocations(0), lastBytes(0), maxAllocations(0), frames(0), allocatingFrames(0) {}
+
+    void beginFrame() {
+        uint64_t count = AllocTracker::threadAllocationCount(), bytes = AllocTracker::threadAllocatedBytes();
+        lastAllocations = count - frameStartCount;
+        lastBytes = bytes - frameStartBytes;
+        frameStartCount = count;
+        frameStartBytes = bytes;
+        ++frames;
+        if (lastAllocations > 0) ++allocatingFrames;
+        if (lastAllocations > maxAllocations) maxAllocations = lastAllocations;
+    }
+
+    // 本帧到目前为止的分配次数
+    uint64_t getCurrentFrameAllocations() const { return AllocTracker::threadAllocationCount() - frameStartCount; }
+    // 上一帧的分配次数/字节数
+    uint64_t getLastFrameAllocations() const { return lastAllocations; }
+    uint64_t getLastFrameBytes() const { return lastBytes; }
+    // 已结算帧中单帧最多分配次数、发生过分配的帧数、已结算帧数
+    uint64_t getMaxFrameAllocations() const { return maxAllocations; }
+    uint64_t getAllocatingFrames() const { return allocatingFrames; }
+    uint64_t getFrameCount() const { return frames; }
+
+private:
+    uint64_t frameStartCount;
+    uint64_t frameStartBytes;
+    uint64_t lastAllocations;
+    uint64_t lastBytes;
+    uint64_t maxAllocations;
+    uint64_t frames;
+    uint64_t allocatingFrames;
+};
+
+#endif // ALLOC_TRACKER_H
@@ -0,0 +1,114 @@
+#include "AssetCache.h"
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace {
+    const char CACHE_MAGIC[4] = { 'M', 'Z', 'T', 'X' };
+    const uint32_t CACHE_VERSION = 2;  // 2：源修改时间改为纳秒精度（版本1的秒级时间戳一律失效）
+    const size_t HEADER_SIZE = 40;   // 像素从第40字节开始（8字节对齐）
+
+    void writeLE(std::ofstream& out, uint64_t value, int bytes) {
+        char buffer[8];
+        for (int i = 0; i < bytes; ++i) buffer[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+        out.write(buffer, bytes);
+    }
+
+    uint64_t readLE(const unsigned char* in, int bytes) {
+        uint64_t value = 0;
+        for (int i = bytes - 1; i >= 0; --i) value = (value << 8) | in[i];
+        return value;
+    }
+}
+
+std::string AssetCache::cachePathFor(const std::string& sourcePath) {
+    return sourcePath + ".rawcache";
+}
+
+// 修改时间取文件系统给出的最高精度（POSIX为纳秒，Windows为100纳秒）：同一秒内改写且大小不变的源文件也能识别
+bool AssetCache::stampOf(const std::string& sourcePath, uint64_t& mtime, uint64_t& size) {
+#ifdef _WIN32
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!GetFileAttributesExA(sourcePath.c_str(), GetFileExInfoStandard, &attributes)) return false;
+    mtime = (static_cast<uint64_t>(attributes.ftLastWriteTime.dwHighDateTime) << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+    size = (static_cast<uint64_t>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+#else
+    struct stat st;
+    if (stat(sourcePath.c_str(), &st) != 0) return false;
+#ifdef __APPLE__
+    const uint64_t nanoseconds = static_cast<uint64_t>(st.st_mtimespec.tv_nsec);
+#else
+    const uint64_t nanoseconds = static_cast<uint64_t>(st.st_mtim.tv_nsec);
+#endif
+    mtime = static_cast<uint64_t>(st.st_mtime) * 1000000000ull + nanoseconds;
+    size = static_cast<uint64_t>(st.st_size);
+#endif
+    return true;
+}
+
+const int AssetCache::MAX_IMAGE_SIZE;
+
+bool AssetCache::open(const std::string& sourcePath, CachedImage& out) {
+    uint64_t mtime = 0, size = 0;
+    if (!stampOf(sourcePath, mtime, size)) return false;
+
+    std::shared_ptr<MappedFile> file(new MappedFile(cachePathFor(sourcePath)));
+    if (!file->isOpen() || file->getSize() < HEADER_SIZE) return false;
+    const unsigned char* header = file->getData();
+    if (std::memcmp(header, CACHE_MAGIC, 4) != 0 || readLE(header + 4, 4) != CACHE_VERSION) return false;
+    if (readLE(header + 8, 8) != mtime || readLE(header + 16, 8) != size) return false; // 源文件已改动
+
+    size_t pixelBytes = static_cast<size_t>(readLE(header + 36, 4));
+    if (file->getSize() != HEADER_SIZE + pixelBytes) return false;  // 截断或多余数据
+    const uint64_t width = readLE(header + 24, 4), height = readLE(header + 28, 4);
+    if (width == 0 || height == 0 || width > MAX_IMAGE_SIZE || height > MAX_IMAGE_SIZE) return false;
+    out.width = static_cast<int>(width);
+    out.height = static_cast<int>(height);
+    out.format = static_cast<int>(readLE(header + 32, 4));
+    out.pixels = header + HEADER_SIZE;
+    out.pixelBytes = pixelBytes;
+    out.file = file;
+    return true;
+}
+
+bool AssetCache::store(const std::string& sourcePath, int width, int height, int format,
+    const void* pixels, size_t pixelBytes) {
+    uint64_t mtime = 0, size = 0;
+    if (!stampOf(sourcePath, mtime, size)) return false;
+
+    const std::string cachePath = cachePathFor(sourcePath);
+    const std::string tempPath = cachePath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+        file.write(CACHE_MAGIC, 4);
+        writeLE(file, CACHE_VERSION, 4);
+        writeLE(file, mtime, 8);
+        writeLE(file, size, 8);
+        writeLE(file, static_cast<uint32_t>(width), 4);
+        writeLE(file, static_cast<uint32_t>(height), 4);
+        writeLE(file, static_cast<uint32_t>(format), 4);
+        writeLE(file, static_cast<uint32_t>(pixelBytes), 4);
+        file.write(static_cast<const char*>(pixels), pixelBytes);
+        if (!file) {
+            file.close();
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+#ifdef _WIN32
+    std::remove(cachePath.c_str()); // Windows上rename不覆盖已有文件
+#endif
+    if (std::rename(tempPath.c_str(), cachePath.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
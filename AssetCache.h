@@ -0,0 +1,41 @@
+#ifndef ASSET_CACHE_H
+#define ASSET_CACHE_H
+#include "MappedFile.h"
+#include <string>
+#include <memory>
+#include <cstdint>
+
+// 缓存中的一张已解码图片（像素直接指向映射内存，file释放前有效）
+struct CachedImage {
+    std::shared_ptr<MappedFile> file;
+    int width;
+    int height;
+    int format;                     // 像素格式（原样保存解码器给出的格式编号，如Raylib的PixelFormat）
+    const unsigned char* pixels;
+    size_t pixelBytes;
+
+    CachedImage() : width(0), height(0), format(0), pixels(nullptr), pixelBytes(0) {}
+};
+
+// 已解码图片的原始像素缓存：存放在源文件旁（<源文件>.rawcache），
+// 文件头记录源文件的修改时间和大小，二者任一变化即视为失效，由调用方重新解码后覆盖写入。
+// 格式：magic "MZTX" + 版本(u32) + 源mtime(u64) + 源大小(u64) + 宽/高/格式/像素字节数(u32)，均为小端，之后紧跟像素。
+// 本类不认识像素格式，只保证像素字节数与文件大小一致；调用方须按自己的格式核对像素字节数与宽高是否相符
+class AssetCache {
+public:
+    static const int MAX_IMAGE_SIZE = 16384;   // 宽高上限，超出视为损坏
+
+    static std::string cachePathFor(const std::string& sourcePath);
+
+    // 通过内存映射打开有效缓存；缓存不存在、损坏（含宽高为0或超出MAX_IMAGE_SIZE）或与源文件不一致时返回false
+    static bool open(const std::string& sourcePath, CachedImage& out);
+    // 写入缓存（先写临时文件再改名，读者不会看到写了一半的文件）；写入失败返回false，不抛异常
+    static bool store(const std::string& sourcePath, int width, int height, int format,
+        const void* pixels, size_t pixelBytes);
+
+    // 读取源文件的修改时间（纳秒级，Windows上为FILETIME）和大小；源文件不存在时返回false。
+    // 同一秒内的两次保存也能区分，MazeWatcher的退化模式同样用它判断文件是否改动
+    static bool stampOf(const std::string& sourcePath, uint64_t& mtime, uint64_t& size);
+};
+
+#endif // ASSET_CACHE_H
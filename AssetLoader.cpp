@@ -0,0 +1,147 @@
+#include "AssetLoader.h"
+#include <algorithm>
+#include <stdexcept>
+
+AssetLoader::AssetLoader(int threadCount, bool useCache)
+    : stopping(false), useCache(useCache), cacheHits(0), doneCount(0) {
+    for (int i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&AssetLoader::workerLoop, this);
+    }
+}
+
+AssetLoader::~AssetLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        pending.clear();
+    }
+    workReady.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (auto& item : decoded) {
+        if (item.image.data != nullptr && !item.mapping) UnloadImage(item.image);
+    }
+    for (auto& pair : textures) {
+        UnloadTexture(pair.second);
+    }
+}
+
+int AssetLoader::defaultThreadCount() {
+    int hardware = static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(1, std::min(hardware, 4));
+}
+
+void AssetLoader::request(const std::string& path) {
+    if (requested.count(path)) return;
+    requested[path] = false;
+    if (workers.empty()) {
+        // 串行模式：当场解码，结果与工作线程一样交给uploadReady上传
+        DecodedImage item = decode(path);
+        std::lock_guard<std::mutex> lock(mutex);
+        decoded.push_back(item);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(path);
+    }
+    workReady.notify_one();
+}
+
+AssetLoader::DecodedImage AssetLoader::decode(const std::string& path) {
+    DecodedImage item;
+    item.path = path;
+    CachedImage cached;
+    // 缓存头的宽高格式须与像素字节数相符，否则上传时会读出映射区之外（损坏或被手工改过的缓存），按未命中重新解码
+    if (useCache && AssetCache::open(path, cached)
+        && cached.pixelBytes == static_cast<size_t>(GetPixelDataSize(cached.width, cached.height, cached.format))) {
+        // 缓存命中：像素留在映射内存中，上传时直接交给GPU，不做拷贝
+        item.image.data = const_cast<unsigned char*>(cached.pixels);
+        item.image.width = cached.width;
+        item.image.height = cached.height;
+        item.image.mipmaps = 1;
+        item.image.format = cached.format;
+        item.mapping = cached.file;
+        cacheHits.fetch_add(1, std::memory_order_relaxed);
+        return item;
+    }
+    item.image = LoadImage(path.c_str());
+    if (useCache && item.image.data != nullptr) {
+        size_t bytes = static_cast<size_t>(GetPixelDataSize(item.image.width, item.image.height, item.image.format));
+        if (!AssetCache::store(path, item.image.width, item.image.height, item.image.format, item.image.data, bytes)) {
+            TraceLog(LOG_WARNING, "Failed to write asset cache for %s", path.c_str());
+        }
+    }
+    return item;
+}
+
+// 工作线程：逐个解码待处理路径
+void AssetLoader::workerLoop() {
+    while (true) {
+        std::string path;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workReady.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (stopping) return;
+            path = pending.front();
+            pending.pop_front();
+        }
+        DecodedImage item = decode(path);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            decoded.push_back(item);
+        }
+        decodeDone.notify_all();
+    }
+}
+
+int AssetLoader::uploadReady() {
+    std::vector<DecodedImage> batch;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        batch.swap(decoded);
+    }
+    int uploaded = 0;
+    for (auto& item : batch) {
+        if (item.image.data != nullptr) {
+            Texture2D tex = LoadTextureFromImage(item.image);
+            if (item.mapping) item.mapping.reset();
+            else UnloadImage(item.image);
+            if (tex.id != 0) {
+                textures[item.path] = tex;
+                ++uploaded;
+            }
+        }
+        requested[item.path] = true;
+        ++doneCount;
+    }
+    return uploaded;
+}
+
+std::unordered_map<std::string, Texture2D>::iterator AssetLoader::waitFor(const std::string& path) {
+    request(path);
+    while (!requested[path]) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            decodeDone.wait(lock, [this] { return !decoded.empty(); });
+        }
+        uploadReady();
+    }
+    auto it = textures.find(path);
+    if (it == textures.end()) {
+        throw std::runtime_error("Failed to load texture: " + path);
+    }
+    return it;
+}
+
+Texture2D AssetLoader::getTexture(const std::string& path) {
+    return waitFor(path)->second;
+}
+
+Texture2D AssetLoader::takeTexture(const std::string& path) {
+    auto it = waitFor(path);
+    Texture2D tex = it->second;
+    textures.erase(it);
+    return tex;
+}
@@ -0,0 +1,78 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+#include "raylib.h"
+#include "AssetCache.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+
+// 异步资源加载（Raylib前端）：图片在工作线程上解码（LoadImage，纯CPU），
+// 解码结果交回主线程上传为纹理（LoadTextureFromImage须在拥有GL上下文的主线程调用）。
+// 主循环每帧调用uploadReady，先完成的先上传，开始界面不必等所有纹理都就绪。
+// 启用缓存时优先从AssetCache映射已解码的像素，直接上传而不解码PNG；缓存失效时解码并重建缓存
+class AssetLoader {
+public:
+    // threadCount：解码线程数；0表示不创建线程，request时直接在主线程同步解码（即原来的串行加载）
+    explicit AssetLoader(int threadCount, bool useCache = true);
+    // 析构：停止工作线程，释放尚未取走的图片和纹理
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // 提交解码（按提交顺序开始解码；重复提交同一路径忽略）
+    void request(const std::string& path);
+    // 主线程：把已解码的图片上传为纹理，返回本次上传数
+    int uploadReady();
+
+    // 已完成（上传成功或解码失败）数 / 已提交数
+    size_t getDoneCount() const { return doneCount; }
+    size_t getRequestedCount() const { return requested.size(); }
+    bool allDone() const { return doneCount == requested.size(); }
+    // 命中像素缓存的图片数（其余为PNG解码）
+    int getCacheHitCount() const { return cacheHits.load(std::memory_order_relaxed); }
+
+    // 查看纹理（所有权仍归加载器）；尚未就绪时阻塞等待该图片解码并上传，加载失败抛出异常
+    Texture2D getTexture(const std::string& path);
+    // 取走纹理（所有权转给调用方，由其UnloadTexture）；等待与失败处理同getTexture
+    Texture2D takeTexture(const std::string& path);
+
+    // 默认解码线程数（硬件线程数，至少1个，最多4个）
+    static int defaultThreadCount();
+
+private:
+    struct DecodedImage {
+        std::string path;
+        Image image;     // data为空表示解码失败
+        std::shared_ptr<MappedFile> mapping; // 非空时image.data指向缓存映射，上传后解除映射而不是UnloadImage
+    };
+
+    // 解码一张图片（先查缓存，未命中则LoadImage并写回缓存），可在任意线程调用
+    DecodedImage decode(const std::string& path);
+    void workerLoop();
+    // 等待path就绪并返回其纹理所在位置
+    std::unordered_map<std::string, Texture2D>::iterator waitFor(const std::string& path);
+
+    std::vector<std::thread> workers;
+    std::deque<std::string> pending;        // 待解码路径（受mutex保护）
+    std::vector<DecodedImage> decoded;      // 已解码待上传（受mutex保护）
+    std::mutex mutex;
+    std::condition_variable workReady;      // 有新的待解码路径
+    std::condition_variable decodeDone;     // 有新的解码结果
+    bool stopping;
+    const bool useCache;
+    std::atomic<int> cacheHits;
+
+    // 以下仅主线程访问
+    std::unordered_map<std::string, bool> requested;       // 已提交路径 → 是否已完成
+    std::unordered_map<std::string, Texture2D> textures;   // 已上传、尚未取走的纹理
+    size_t doneCount;
+};
+
+#endif // ASSET_LOADER_H
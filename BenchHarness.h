@@ -0,0 +1,119 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+#include "AllocTracker.h"
+#include <string>
+#include <vector>
+#include <chrono>
+#include <ostream>
+#include <algorithm>
+#include <cstddef>
+
+// 单个基准用例结果
+struct BenchResult {
+    std::string name;        // 用例名（如 "bfs"）
+    std::string maze;        // 迷宫名（文件名或生成参数）
+    int rows = 0;
+    int cols = 0;
+    long long iterations = 0;    // 计时循环中的调用次数
+    double nsPerOp = 0.0;        // 平均每次操作耗时（纳秒）
+    double minNsPerOp = 0.0;     // 单次调用最快耗时（纳秒/操作）
+    size_t peakBytes = 0;        // 单次调用期间的峰值额外堆占用
+    std::vector<std::pair<std::string, double>> metrics; // 附加指标（路径长度、扩展节点数等）
+};
+
+// 极简基准框架：先预热一次（同时测量峰值内存），再循环计时到最短时长或最大次数
+class BenchHarness {
+public:
+    BenchHarness(double minSeconds = 0.2, long long maxIterations = 1000000)
+        : minSeconds(minSeconds), maxIterations(maxIterations) {}
+
+    // fn(BenchResult&)：执行一次被测操作，可向result.metrics写入指标；
+    // opsPerCall：一次调用内包含的操作数（如一次调用推进1000个逻辑步）
+    template<typename Fn>
+    BenchResult& run(const std::string& name, const std::string& maze, int rows, int cols, Fn fn, long long opsPerCall = 1) {
+        typedef std::chrono::steady_clock Clock;
+        BenchResult result;
+        result.name = name;
+        result.maze = maze;
+        result.rows = rows;
+        result.cols = cols;
+
+        // 1. 预热：测峰值内存，同时估计单次耗时
+        size_t baseline = AllocTracker::currentBytes();
+        AllocTracker::resetPeak();
+        Clock::time_point begin = Clock::now();
+        fn(result);
+        double warmNs = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+        result.peakBytes = AllocTracker::peakBytes() - baseline;
+
+        // 2. 计时循环（单次已超过最短时长的大用例直接采用预热结果）
+        double totalNs = warmNs, minNs = warmNs;
+        long long iterations = 1;
+        if (warmNs < minSeconds * 1e9) {
+            totalNs = 0.0;
+            iterations = 0;
+            while (iterations < maxIterations && totalNs < minSeconds * 1e9) {
+                BenchResult scratch;
+                Clock::time_point t0 = Clock::now();
+                fn(scratch);
+                double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+                totalNs += ns;
+                minNs = std::min(minNs, ns);
+                ++iterations;
+            }
+        }
+
+        result.iterations = iterations;
+        result.nsPerOp = totalNs / iterations / opsPerCall;
+        result.minNsPerOp = minNs / opsPerCall;
+        results.push_back(result);
+        return results.back();
+    }
+
+    // 记录一个被跳过的用例（如按更小规模外推已超出时间预算；estimatedSeconds为外推的单次耗时）
+    void skip(const std::string& name, const std::string& maze, int rows, int cols, double estimatedSeconds) {
+        BenchResult result;
+        result.name = name;
+        result.maze = maze;
+        result.rows = rows;
+        result.cols = cols;
+        result.metrics = { {"skipped", 1}, {"estimated_seconds", estimatedSeconds} };
+        results.push_back(result);
+    }
+
+    const std::vector<BenchResult>& getResults() const { return results; }
+
+    // 输出JSON（便于版本间对比回归）
+    void writeJson(std::ostream& out) const {
+        out << "{\n  \"benchmarks\": [\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const BenchResult& r = results[i];
+            out << "    {\"name\": \"" << escape(r.name) << "\", \"maze\": \"" << escape(r.maze)
+                << "\", \"rows\": " << r.rows << ", \"cols\": " << r.cols
+                << ", \"iterations\": " << r.iterations
+                << ", \"ns_per_op\": " << r.nsPerOp << ", \"min_ns_per_op\": " << r.minNsPerOp
+                << ", \"peak_bytes\": " << r.peakBytes;
+            for (const auto& m : r.metrics) {
+                out << ", \"" << escape(m.first) << "\": " << m.second;
+            }
+            out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+
+private:
+    double minSeconds;
+    long long maxIterations;
+    std::vector<BenchResult> results;
+
+    static std::string escape(const std::string& text) {
+        std::string out;
+        for (char c : text) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
+    }
+};
+
+#endif // BENCH_HARNESS_H
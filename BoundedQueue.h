@@ -0,0 +1,71 @@
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <utility>
+#include <cstddef>
+
+// 有界阻塞队列（流水线相邻阶段之间使用，容量即两阶段之间最多积压的元素数，从而限制内存）：
+// 队满时push等待，队空时pop等待；close之后push返回false，pop取完剩余元素后返回false
+template<typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : capacity(capacity == 0 ? 1 : capacity), closed(false),
+        fullWaits(0), emptyWaits(0), peakSize(0) {}
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    bool push(T value) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (items.size() >= capacity && !closed) ++fullWaits;
+        notFull.wait(lock, [this] { return items.size() < capacity || closed; });
+        if (closed) return false;
+        items.push_back(std::move(value));
+        if (items.size() > peakSize) peakSize = items.size();
+        lock.unlock();
+        notEmpty.notify_one();
+        return true;
+    }
+
+    bool pop(T& out) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (items.empty() && !closed) ++emptyWaits;
+        notEmpty.wait(lock, [this] { return !items.empty() || closed; });
+        if (items.empty()) return false;
+        out = std::move(items.front());
+        items.pop_front();
+        lock.unlock();
+        notFull.notify_one();
+        return true;
+    }
+
+    // 不再接受新元素（已入队的仍可取出），唤醒所有等待者
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+        }
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+
+    // 统计：push因队满等待的次数（下游是瓶颈）、pop因队空等待的次数（上游是瓶颈）、峰值长度
+    size_t getFullWaits() const { std::lock_guard<std::mutex> lock(mutex); return fullWaits; }
+    size_t getEmptyWaits() const { std::lock_guard<std::mutex> lock(mutex); return emptyWaits; }
+    size_t getPeakSize() const { std::lock_guard<std::mutex> lock(mutex); return peakSize; }
+
+private:
+    const size_t capacity;
+    std::deque<T> items;
+    mutable std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+    bool closed;
+    size_t fullWaits;
+    size_t emptyWaits;
+    size_t peakSize;
+};
+
+#endif // BOUNDED_QUEUE_H
@@ -0,0 +1,30 @@
+#include "CellGrid.h"
+
+// 构造：按布局拷贝地块并预先算好各方向在块内/跨块时的序号偏移
+CellGrid::CellGrid(const Maze& maze, CellLayout layout)
+    : rows(maze.rows), cols(maze.cols), layout(layout), tilesPerRow(0), edgeMask(-1) {
+    if (layout == CellLayout::ROW_MAJOR) {
+        // 行主序没有“块”：edgeMask为-1时跨块判断恒为false，只用第0列偏移
+        const int rowMajor[4] = { -cols, cols, -1, 1 };
+        for (int dir = 0; dir < 4; ++dir) offsets[dir][0] = offsets[dir][1] = rowMajor[dir];
+        cells.resize(static_cast<size_t>(rows) * cols);
+    }
+    else {
+        const int tileCells = TILE_SIZE * TILE_SIZE;
+        const int tileRows = (rows + TILE_SIZE - 1) >> TILE_SHIFT;
+        tilesPerRow = (cols + TILE_SIZE - 1) >> TILE_SHIFT;
+        edgeMask = TILE_SIZE - 1;
+        const int tileStride = tilesPerRow * tileCells;   // 上下相邻两块的序号差
+        const int lastRow = (TILE_SIZE - 1) * TILE_SIZE;  // 块内最后一行的起始偏移
+        offsets[0][0] = -TILE_SIZE;  offsets[0][1] = -tileStride + lastRow;
+        offsets[1][0] = TILE_SIZE;   offsets[1][1] = tileStride - lastRow;
+        offsets[2][0] = -1;          offsets[2][1] = -tileCells + TILE_SIZE - 1;
+        offsets[3][0] = 1;           offsets[3][1] = tileCells - (TILE_SIZE - 1);
+        cells.assign(static_cast<size_t>(tileRows) * tilesPerRow * tileCells, static_cast<int8_t>(BlockType::WALL));
+    }
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            cells[index(row, col)] = static_cast<int8_t>(maze.mapData[row][col]);
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef CELL_GRID_H
+#define CELL_GRID_H
+#include "MazeParser.h"
+#include "PathFinder.h"
+#include <vector>
+#include <cstdint>
+
+// 地块存储布局
+enum class CellLayout {
+    ROW_MAJOR,  // 行主序：上下邻格相隔一整行
+    TILED       // 8×8分块：每块64格连续存放（块内行主序，块按行主序排列），上下邻格多数落在同一块内
+};
+
+// 扁平地块网格（寻路引擎使用的只读副本）：每格1字节，格子序号的计算全部封装在index/position/neighbor中，
+// 搜索状态数组按同一序号存放，因此分块布局同时改善地块和距离/前驱数组的局部性。
+// 分块布局把行列补齐到8的倍数，补齐的格子视为墙
+class CellGrid {
+public:
+    static const int TILE_SHIFT = 3;
+    static const int TILE_SIZE = 1 << TILE_SHIFT;   // 分块边长（8）
+
+    CellGrid(const Maze& maze, CellLayout layout);
+
+    // 默认布局：一律行主序。分块布局在宽迷宫上的计时互有胜负（MazeBench的flat_*_tiled与flat_*_row_major），
+    // 也还没有缓存未命中数的实测证明它更省，因此只在显式指定时使用
+    static CellLayout preferredLayout(const Maze&) {
+        return CellLayout::ROW_MAJOR;
+    }
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    CellLayout getLayout() const { return layout; }
+    // 存储格数（含分块补齐），状态数组按此大小分配
+    size_t getCellCount() const { return cells.size(); }
+
+    int index(int row, int col) const {
+        if (layout == CellLayout::ROW_MAJOR) return row * cols + col;
+        int tile = (row >> TILE_SHIFT) * tilesPerRow + (col >> TILE_SHIFT);
+        return (tile << (2 * TILE_SHIFT)) | ((row & (TILE_SIZE - 1)) << TILE_SHIFT) | (col & (TILE_SIZE - 1));
+    }
+
+    Point position(int cell) const {
+        if (layout == CellLayout::ROW_MAJOR) return { cell / cols, cell % cols };
+        int tile = cell >> (2 * TILE_SHIFT);
+        int tileRow = tile / tilesPerRow;
+        int tileCol = tile - tileRow * tilesPerRow;
+        return { (tileRow << TILE_SHIFT) | ((cell >> TILE_SHIFT) & (TILE_SIZE - 1)),
+            (tileCol << TILE_SHIFT) | (cell & (TILE_SIZE - 1)) };
+    }
+
+    BlockType at(int cell) const { return static_cast<BlockType>(cells[cell]); }
+
+    // 第dir个方向（与PathFinder相同的上、下、左、右顺序）的邻格序号，越界返回-1。
+    // (row, col)为cell的坐标（调用方已知，避免再解码一次）
+    int neighbor(int cell, int row, int col, int dir) const {
+        switch (dir) {
+        case 0:  return row == 0 ? -1 : cell + offsets[0][(row & edgeMask) == 0];
+        case 1:  return row + 1 == rows ? -1 : cell + offsets[1][(row & edgeMask) == edgeMask];
+        case 2:  return col == 0 ? -1 : cell + offsets[2][(col & edgeMask) == 0];
+        default: return col + 1 == cols ? -1 : cell + offsets[3][(col & edgeMask) == edgeMask];
+        }
+    }
+
+private:
+    int rows;
+    int cols;
+    CellLayout layout;
+    int tilesPerRow;
+    int edgeMask;                 // 分块内坐标掩码（行主序时为-1，使“块边缘”判断恒为同一分支）
+    int offsets[4][2];            // [方向][是否跨块] → 序号偏移
+    std::vector<int8_t> cells;
+};
+
+#endif // CELL_GRID_H
@@ -0,0 +1,111 @@
+#include "CollisionMap.h"
+#include <algorithm>
+
+// 构造：打包墙体位图，并按需计算距离场
+CollisionMap::CollisionMap(const Maze& maze, bool buildDistanceField)
+    : rows(maze.rows), cols(maze.cols), wordsPerRow((maze.cols + 63) / 64) {
+    wallBits.assign(static_cast<size_t>(rows) * wordsPerRow, 0);
+    for (int row = 0; row < rows; ++row) {
+        const std::vector<BlockType>& line = maze.mapData[row];
+        uint64_t* words = &wallBits[static_cast<size_t>(row) * wordsPerRow];
+        for (int col = 0; col < cols; ++col) {
+            if (line[col] == BlockType::WALL) {
+                words[col >> 6] |= uint64_t(1) << (col & 63);
+            }
+        }
+    }
+
+    if (buildDistanceField) {
+        computeDistanceField();
+    }
+}
+
+// 两遍扫描计算切比雪夫距离（8邻域单位权重的倒角距离对切比雪夫度量是精确的）
+void CollisionMap::computeDistanceField() {
+    const int MAX_DIST = 0xFFFF;
+    wallDistance.assign(static_cast<size_t>(rows) * cols, 0);
+
+    // 初始化：墙格为0，其余格取到迷宫外边界的距离（越界视为墙）
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            if (isWall(row, col)) continue;
+            int border = std::min(std::min(row + 1, rows - row), std::min(col + 1, cols - col));
+            wallDistance[row * cols + col] = static_cast<uint16_t>(std::min(border, MAX_DIST));
+        }
+    }
+
+    auto relax = [this](int row, int col, int nRow, int nCol) {
+        if (nRow < 0 || nRow >= rows || nCol < 0 || nCol >= cols) return;
+        uint16_t& d = wallDistance[row * cols + col];
+        int candidate = wallDistance[nRow * cols + nCol] + 1;
+        if (candidate < d) d = static_cast<uint16_t>(candidate);
+    };
+
+    // 正向扫描：左上、上、右上、左
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            relax(row, col, row - 1, col - 1);
+            relax(row, col, row - 1, col);
+            relax(row, col, row - 1, col + 1);
+            relax(row, col, row, col - 1);
+        }
+    }
+    // 反向扫描：右下、下、左下、右
+    for (int row = rows - 1; row >= 0; --row) {
+        for (int col = cols - 1; col >= 0; --col) {
+            relax(row, col, row + 1, col + 1);
+            relax(row, col, row + 1, col);
+            relax(row, col, row + 1, col - 1);
+            relax(row, col, row, col + 1);
+        }
+    }
+}
+
+int CollisionMap::nearestWallDistance(int row, int col) const {
+    if (isWall(row, col)) return 0;
+    const int border = std::min(std::min(row + 1, rows - row), std::min(col + 1, cols - col));
+    for (int r = 1; r < border; ++r) {
+        for (int c = col - r; c <= col + r; ++c) {
+            if (isWall(row - r, c) || isWall(row + r, c)) return r;
+        }
+        for (int rr = row - r + 1; rr <= row + r - 1; ++rr) {
+            if (isWall(rr, col - r) || isWall(rr, col + r)) return r;
+        }
+    }
+    return std::min(border, 0xFFFF);
+}
+
+// 只有一格墙体状态变化时，受影响的格子q满足“旧距离或新距离 >= q到该格的切比雪夫距离”；
+// 距离场是1-Lipschitz的，所以从改动格逐环向外重算，某一环上没有这样的格子即可停止
+void CollisionMap::setWall(int row, int col, bool wall) {
+    uint64_t& word = wallBits[row * wordsPerRow + (col >> 6)];
+    const uint64_t bit = uint64_t(1) << (col & 63);
+    word = wall ? (word | bit) : (word & ~bit);
+    if (!hasDistanceField()) return;
+
+    const int maxRadius = std::max(rows, cols);
+    for (int r = 0; r <= maxRadius; ++r) {
+        bool affected = false;
+        auto visit = [&](int rr, int cc) {
+            if (rr < 0 || rr >= rows || cc < 0 || cc >= cols) return;
+            uint16_t& d = wallDistance[rr * cols + cc];
+            int fresh = nearestWallDistance(rr, cc);
+            if (d >= r || fresh >= r) affected = true;
+            d = static_cast<uint16_t>(fresh);
+        };
+        if (r == 0) {
+            visit(row, col);
+        }
+        else {
+            for (int c = col - r; c <= col + r; ++c) {
+                visit(row - r, c);
+                visit(row + r, c);
+            }
+            for (int rr = row - r + 1; rr <= row + r - 1; ++rr) {
+                visit(rr, col - r);
+                visit(rr, col + r);
+            }
+        }
+        if (!affected) break;
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef COLLISION_MAP_H
+#define COLLISION_MAP_H
+#include "MazeParser.h"
+#include <vector>
+#include <cstdint>
+
+// 碰撞加速结构（迷宫加载后构建一次，无头核心）：
+// 1. 墙体位图：每格1位，按行打包为64位字，查询不再经过嵌套vector
+// 2. 距墙距离场（可选）：每格到最近墙格的切比雪夫距离（越界视为墙），
+//    远离墙体的移动只需一次查表即可直接放行
+class CollisionMap {
+public:
+    CollisionMap() : rows(0), cols(0), wordsPerRow(0) {}
+    // 构造：从迷宫构建位图，buildDistanceField为true时同时构建距离场
+    explicit CollisionMap(const Maze& maze, bool buildDistanceField = true);
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+
+    // 是否为墙（越界视为墙）
+    bool isWall(int row, int col) const {
+        if (row < 0 || row >= rows || col < 0 || col >= cols) {
+            return true;
+        }
+        return (wallBits[row * wordsPerRow + (col >> 6)] >> (col & 63)) & 1u;
+    }
+
+    // 热重载：改写单格墙体位，并局部更新距离场（多格改动须逐格调用，每次只差一格时局部更新才精确）
+    void setWall(int row, int col, bool wall);
+
+    bool hasDistanceField() const { return !wallDistance.empty(); }
+    // 到最近墙格的切比雪夫距离（格数；墙格为0，越界返回0）
+    int distanceToWall(int row, int col) const {
+        if (row < 0 || row >= rows || col < 0 || col >= cols) {
+            return 0;
+        }
+        return wallDistance[row * cols + col];
+    }
+
+private:
+    int rows;
+    int cols;
+    int wordsPerRow;                     // 每行占用的64位字数
+    std::vector<uint64_t> wallBits;      // 墙体位图
+    std::vector<uint16_t> wallDistance;  // 距墙距离场（未构建时为空）
+
+    // 两遍扫描（正向+反向，8邻域）计算切比雪夫距离场
+    void computeDistanceField();
+    // 按环向外查找单格到最近墙格（含迷宫外边界）的距离
+    int nearestWallDistance(int row, int col) const;
+};
+
+#endif // COLLISION_MAP_H
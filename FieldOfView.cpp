@@ -0,0 +1,112 @@
+#include "FieldOfView.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // 8个八分区的坐标变换（列偏移 = dx*xx + dy*xy，行偏移 = dx*yx + dy*yy）
+    const int OCTANTS[8][4] = {
+        {  1,  0,  0,  1 }, {  0,  1,  1,  0 }, {  0, -1,  1,  0 }, { -1,  0,  0,  1 },
+        { -1,  0,  0, -1 }, {  0, -1, -1,  0 }, {  0,  1, -1,  0 }, {  1,  0,  0, -1 }
+    };
+}
+
+// 构造：建墙体位图，可见/已探索位图清零
+FieldOfView::FieldOfView(const Maze& maze, int radius)
+    : rows(maze.rows), cols(maze.cols), wordsPerRow((maze.cols + 63) / 64),
+    radius(radius > 0 ? radius : maze.rows + maze.cols),
+    walls(static_cast<size_t>(maze.rows) * ((maze.cols + 63) / 64), 0),
+    visible(walls.size(), 0), explored(walls.size(), 0),
+    viewer({ -1, -1 }), visibleCount(0) {
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            if (maze.mapData[row][col] == BlockType::WALL) {
+                walls[row * wordsPerRow + (col >> 6)] |= uint64_t(1) << (col & 63);
+            }
+        }
+    }
+}
+
+void FieldOfView::setCell(int row, int col, BlockType type) {
+    uint64_t& word = walls[row * wordsPerRow + (col >> 6)];
+    const uint64_t bit = uint64_t(1) << (col & 63);
+    if (type == BlockType::WALL) word |= bit;
+    else word &= ~bit;
+    invalidate();
+}
+
+void FieldOfView::resetExplored() {
+    std::fill(explored.begin(), explored.end(), uint64_t(0));
+    // 当前可见的格子仍算已探索
+    for (size_t index : touchedWords) explored[index] = visible[index];
+}
+
+void FieldOfView::markVisible(int row, int col) {
+    const size_t index = row * wordsPerRow + (col >> 6);
+    const uint64_t bit = uint64_t(1) << (col & 63);
+    if (visible[index] & bit) return; // 八分区的边界格会被相邻两个八分区各访问一次
+    if (visible[index] == 0) touchedWords.push_back(index);
+    visible[index] |= bit;
+    explored[index] |= bit;
+    ++visibleCount;
+}
+
+bool FieldOfView::update(const Point& newViewer) {
+    if (newViewer == viewer) return false;
+    // 只清上一次置过位的字（容量保留，稳态下不分配）
+    for (size_t index : touchedWords) visible[index] = 0;
+    touchedWords.clear();
+    viewer = newViewer;
+    visibleCount = 0;
+    if (viewer.row < 0 || viewer.row >= rows || viewer.col < 0 || viewer.col >= cols) return true;
+
+    markVisible(viewer.row, viewer.col);
+    for (const auto& octant : OCTANTS) {
+        castLight(1, 1.0, 0.0, octant[0], octant[1], octant[2], octant[3]);
+    }
+    return true;
+}
+
+// 递归阴影投射：逐行（离观察者depth格）从斜率大的一端扫向小的一端；
+// 遇到墙时以墙前的斜率区间递归处理更远的行，墙后的区间被遮住，继续在墙之后找下一段开口
+void FieldOfView::castLight(int depth, double startSlope, double endSlope, int xx, int xy, int yx, int yy) {
+    if (startSlope < endSlope) return;
+    const int radiusSquared = radius * radius;
+    double nextStart = startSlope;
+    for (int distance = depth; distance <= radius; ++distance) {
+        const int dy = -distance;
+        bool blocked = false;
+        // 直接从斜率区间的起点所在格开始（远处的窄视线不必从行首逐格跳过，否则长视线开销按长度平方增长）；
+        // 向下取整多取的一格由下面的斜率判断跳过
+        const int firstDx = std::max(-distance, static_cast<int>(std::floor(-startSlope * (distance + 0.5) - 0.5)));
+        for (int dx = firstDx; dx <= 0; ++dx) {
+            // 该格左右两角相对观察者的斜率
+            const double leftSlope = (dx - 0.5) / (dy + 0.5);
+            const double rightSlope = (dx + 0.5) / (dy - 0.5);
+            if (startSlope < rightSlope) continue;
+            if (endSlope > leftSlope) break;
+
+            const int col = viewer.col + dx * xx + dy * xy;
+            const int row = viewer.row + dx * yx + dy * yy;
+            const bool opaque = isOpaque(row, col);
+            if (dx * dx + dy * dy < radiusSquared && !(row < 0 || row >= rows || col < 0 || col >= cols)) {
+                markVisible(row, col);
+            }
+
+            if (blocked) {
+                if (opaque) {
+                    nextStart = rightSlope;
+                }
+                else {
+                    blocked = false;
+                    startSlope = nextStart;
+                }
+            }
+            else if (opaque && distance < radius) {
+                blocked = true;
+                castLight(distance + 1, startSlope, leftSlope, xx, xy, yx, yy);
+                nextStart = rightSlope;
+            }
+        }
+        if (blocked) break;
+    }
+}
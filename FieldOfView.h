@@ -0,0 +1,63 @@
+#ifndef FIELD_OF_VIEW_H
+#define FIELD_OF_VIEW_H
+#include "PathFinder.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// 视野（战争迷雾，无头核心）：墙体打包成位图（每格1位，每行按64位字对齐），
+// 以观察者所在格为中心做8个八分区的递归阴影投射（shadowcasting），结果存为可见/已探索两张位图。
+// 只在观察者换格时重算；重算前只清除上一次置过位的字，开销与可见格数成正比，与地图大小无关
+class FieldOfView {
+public:
+    // radius为视野半径（格，欧氏距离）；0表示不限，只受墙遮挡
+    explicit FieldOfView(const Maze& maze, int radius = 0);
+
+    // 观察者位于viewer格：与上次相同时直接返回false，否则重算可见区域、并入已探索区域后返回true
+    bool update(const Point& viewer);
+    // 下一次update必定重算（墙体改变后调用）
+    void invalidate() { viewer = { -1, -1 }; }
+    // 热重载：改写单格的遮挡状态（只有墙遮挡视线），并使当前视野失效
+    void setCell(int row, int col, BlockType type);
+    // 清空已探索区域（换关/重开时）
+    void resetExplored();
+
+    bool isVisible(int row, int col) const { return testBit(visible, row, col); }
+    bool isExplored(int row, int col) const { return testBit(explored, row, col); }
+    // 按位图字读取一行的64格（bit i为第word*64+i列），绘制时整字跳过全可见/全未探索的区域
+    uint64_t visibleWord(int row, int word) const { return visible[row * wordsPerRow + word]; }
+    uint64_t exploredWord(int row, int word) const { return explored[row * wordsPerRow + word]; }
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    int getWordsPerRow() const { return wordsPerRow; }
+    const Point& getViewer() const { return viewer; }
+    // 上次重算得到的可见格数（含看得见的墙）
+    size_t getVisibleCount() const { return visibleCount; }
+
+private:
+    // 一个八分区内从第depth行开始、斜率[endSlope, startSlope]之间的阴影投射；
+    // (xx, xy, yx, yy)把八分区内的局部坐标变换为地图上的列/行偏移
+    void castLight(int depth, double startSlope, double endSlope, int xx, int xy, int yx, int yy);
+    void markVisible(int row, int col);
+    // 越界视为遮挡
+    bool isOpaque(int row, int col) const {
+        return row < 0 || row >= rows || col < 0 || col >= cols || testBit(walls, row, col);
+    }
+    bool testBit(const std::vector<uint64_t>& bits, int row, int col) const {
+        return (bits[row * wordsPerRow + (col >> 6)] >> (col & 63)) & 1u;
+    }
+
+    int rows;
+    int cols;
+    int wordsPerRow;
+    int radius;                      // 实际使用的半径（不限时取行数+列数）
+    std::vector<uint64_t> walls;     // 遮挡位图
+    std::vector<uint64_t> visible;   // 当前可见
+    std::vector<uint64_t> explored;  // 曾经可见
+    Point viewer;                    // 上次重算时观察者所在格（{-1,-1}表示需要重算）
+    size_t visibleCount;
+    std::vector<size_t> touchedWords; // 当前可见位图中非零的字的下标，下次重算前只清这些字
+};
+
+#endif // FIELD_OF_VIEW_H
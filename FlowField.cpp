@@ -0,0 +1,155 @@
+#include "FlowField.h"
+#include "GameTypes.h"
+#include <queue>
+#include <functional>
+#include <utility>
+
+const int FlowField::UNREACHABLE;
+
+// 以target为终点BFS，随后为每格挑选距离更小的邻格作为下一步
+void FlowField::build(const CollisionMap& collision, const Point& target) {
+    rows = collision.getRows();
+    cols = collision.getCols();
+    this->target = target;
+
+    const size_t cellCount = static_cast<size_t>(rows) * cols;
+    distance.assign(cellCount, UNREACHABLE);
+    stepX.resize(cellCount);
+    stepY.resize(cellCount);
+
+    const int dirs[4][2] = { {-1,0}, {1,0}, {0,-1}, {0,1} };
+
+    // 1. BFS：计算每格到目标的步数（数组模拟队列，避免逐节点分配）
+    std::vector<int> queue;
+    queue.reserve(cellCount);
+    if (!collision.isWall(target.row, target.col)) {
+        distance[target.row * cols + target.col] = 0;
+        queue.push_back(target.row * cols + target.col);
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int cell = queue[head];
+        int row = cell / cols, col = cell % cols;
+        for (const auto& dir : dirs) {
+            int newRow = row + dir[0], newCol = col + dir[1];
+            if (collision.isWall(newRow, newCol)) continue;
+            int next = newRow * cols + newCol;
+            if (distance[next] != UNREACHABLE) continue;
+            distance[next] = distance[cell] + 1;
+            queue.push_back(next);
+        }
+    }
+
+    // 2. 下一步：指向距离更小的邻格中心（目标格和不可达格指向自身中心）
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            computeStep(collision, row, col);
+        }
+    }
+}
+
+void FlowField::computeStep(const CollisionMap& collision, int row, int col) {
+    const int dirs[4][2] = { {-1,0}, {1,0}, {0,-1}, {0,1} };
+    const float half = TILE_SIZE * 0.5f;
+    int cell = row * cols + col;
+    int bestRow = row, bestCol = col;
+    int bestDist = distance[cell];
+    if (bestDist > 0) {
+        for (const auto& dir : dirs) {
+            int newRow = row + dir[0], newCol = col + dir[1];
+            if (collision.isWall(newRow, newCol)) continue;
+            int d = distance[newRow * cols + newCol];
+            if (d != UNREACHABLE && d < bestDist) {
+                bestDist = d;
+                bestRow = newRow;
+                bestCol = newCol;
+            }
+        }
+    }
+    stepX[cell] = bestCol * TILE_SIZE + half;
+    stepY[cell] = bestRow * TILE_SIZE + half;
+}
+
+// 增量修复：
+// 1. 新墙格及所有“沿距离+1依赖它”的格子（最短路可能经过它）作废；
+// 2. 作废格和新打通的格按未作废邻格取初值，再用小根堆向外松弛（也覆盖打通后距离变短的区域）；
+// 3. 距离变化的格子及其邻格重新挑选下一步
+void FlowField::updateWalls(const CollisionMap& collision, const std::vector<Point>& cells) {
+    if (collision.isWall(target.row, target.col)) {
+        build(collision, target);  // 目标格本身被堵死：整体重建（全部不可达）
+        return;
+    }
+    const int dirs[4][2] = { {-1,0}, {1,0}, {0,-1}, {0,1} };
+    std::vector<int> changed;
+
+    // 1. 作废依赖新墙格的区域
+    std::vector<int> invalid;
+    for (const Point& p : cells) {
+        int cell = p.row * cols + p.col;
+        if (collision.isWall(p.row, p.col) && distance[cell] != UNREACHABLE) {
+            invalid.push_back(cell);
+        }
+    }
+    for (size_t head = 0; head < invalid.size(); ++head) {
+        int cell = invalid[head];
+        int row = cell / cols, col = cell % cols;
+        int d = distance[cell];
+        if (d == UNREACHABLE) continue;   // 已经处理过
+        distance[cell] = UNREACHABLE;
+        changed.push_back(cell);
+        for (const auto& dir : dirs) {
+            int newRow = row + dir[0], newCol = col + dir[1];
+            if (collision.isWall(newRow, newCol)) continue;
+            int next = newRow * cols + newCol;
+            if (distance[next] == d + 1) invalid.push_back(next);
+        }
+    }
+
+    // 2. 取初值并松弛
+    typedef std::pair<int, int> Entry; // (距离, 格子)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    auto seed = [&](int cell) {
+        int row = cell / cols, col = cell % cols;
+        if (collision.isWall(row, col)) return;
+        int best = distance[cell];
+        for (const auto& dir : dirs) {
+            int newRow = row + dir[0], newCol = col + dir[1];
+            if (collision.isWall(newRow, newCol)) continue;
+            int d = distance[newRow * cols + newCol];
+            if (d != UNREACHABLE && (best == UNREACHABLE || d + 1 < best)) best = d + 1;
+        }
+        if (best != UNREACHABLE && best != distance[cell]) {
+            distance[cell] = best;
+            changed.push_back(cell);
+        }
+        if (best != UNREACHABLE) heap.push({ best, cell });
+    };
+    for (int cell : invalid) seed(cell);
+    for (const Point& p : cells) seed(p.row * cols + p.col);
+
+    while (!heap.empty()) {
+        Entry top = heap.top();
+        heap.pop();
+        if (top.first != distance[top.second]) continue;  // 过期条目
+        int row = top.second / cols, col = top.second % cols;
+        for (const auto& dir : dirs) {
+            int newRow = row + dir[0], newCol = col + dir[1];
+            if (collision.isWall(newRow, newCol)) continue;
+            int next = newRow * cols + newCol;
+            if (distance[next] == UNREACHABLE || distance[next] > top.first + 1) {
+                distance[next] = top.first + 1;
+                changed.push_back(next);
+                heap.push({ top.first + 1, next });
+            }
+        }
+    }
+
+    // 3. 重新挑选下一步
+    for (int cell : changed) {
+        int row = cell / cols, col = cell % cols;
+        computeStep(collision, row, col);
+        for (const auto& dir : dirs) {
+            int newRow = row + dir[0], newCol = col + dir[1];
+            if (newRow >= 0 && newRow < rows && newCol >= 0 && newCol < cols) computeStep(collision, newRow, newCol);
+        }
+    }
+}
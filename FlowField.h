@@ -0,0 +1,42 @@
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+#include "CollisionMap.h"
+#include "PathFinder.h"
+#include <vector>
+
+// 流场（无头核心）：从目标格做一次BFS，记录每格到目标的步数，以及沿最短路下一格的中心坐标。
+// 所有NPC共享同一份流场，每个NPC只需按所在格查表即可得到前进方向。
+class FlowField {
+public:
+    static const int UNREACHABLE = -1;
+
+    FlowField() : rows(0), cols(0), target({ -1, -1 }) {}
+
+    // 以target为终点重建流场（开销O(格子数)，目标格变化时才需调用）
+    void build(const CollisionMap& collision, const Point& target);
+    // 热重载：cells的墙体状态已在collision中改写，只修复受影响的格子（开销与受影响区域成正比）
+    void updateWalls(const CollisionMap& collision, const std::vector<Point>& cells);
+
+    const Point& getTarget() const { return target; }
+    bool isBuilt() const { return !distance.empty(); }
+
+    // 按格子序号（row * cols + col）查询
+    int distanceAt(int cell) const { return distance[cell]; }
+    // 下一步应前往的格子中心像素坐标（不可达格为自身中心）
+    const float* stepTargetX() const { return stepX.data(); }
+    const float* stepTargetY() const { return stepY.data(); }
+    const int* distances() const { return distance.data(); }
+
+private:
+    // 为单格挑选距离更小的邻格作为下一步
+    void computeStep(const CollisionMap& collision, int row, int col);
+
+    int rows;
+    int cols;
+    Point target;
+    std::vector<int> distance;  // 到目标的步数（UNREACHABLE表示不可达）
+    std::vector<float> stepX;   // 下一格中心X
+    std::vector<float> stepY;   // 下一格中心Y
+};
+
+#endif // FLOW_FIELD_H
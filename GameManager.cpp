@@ -1,154 +1,421 @@
 #include "GameManager.h"
 #include "raylib.h"
+#include "Profiler.h"
 #include <string>
 #include <stdexcept>
+#include <fstream>
+#include <chrono>
 
-// 캯ͷļеʵƵͬʱرͼ
-GameManager::GameManager(const Maze& maze, const TextureManager& texManager, const std::string& playerTexPath)
-    : maze(maze), texManager(texManager),
-    player(findStartPoint(maze), playerTexPath),
-    pathFinder(maze),
-    gameState(GameState::START_SCREEN),
-    // ؿʼ汳ͼ
-    startBgTexture(LoadTexture("./resource/start_bg.png")) {
-    // 鱳ͼǷسɹ
-    if (startBgTexture.id == 0) {
-        throw std::runtime_error("Failed to load start screen background: ./resource/start_bg.png");
+namespace {
+    const unsigned SLIME_SEED = 20240601u; // 史莱姆生成种子（各关卡相同）
+
+    // 沿关卡预处理好的终点距离场从from走到终点，写入path（步数最短；不可达时为空；复用path的容量）
+    void followExitField(const Level& level, const Point& from, std::vector<Point>& path) {
+        const FlowField& field = level.getExitField();
+        const int cols = level.getMaze().cols;
+        path.clear();
+        int cell = from.row * cols + from.col;
+        if (field.distanceAt(cell) == FlowField::UNREACHABLE) return;
+        path.push_back(from);
+        while (field.distanceAt(cell) > 0) {
+            int row = static_cast<int>(field.stepTargetY()[cell]) / TILE_SIZE;
+            int col = static_cast<int>(field.stepTargetX()[cell]) / TILE_SIZE;
+            cell = row * cols + col;
+            path.push_back({ row, col });
+        }
     }
 }
 
-// ͷűͼ
+const char* const GameManager::START_BG_PATH = "./resource/start_bg.png";
+const char* const GameManager::SLIME_TEX_PATH = "./resource/slime.png";
+const int GameManager::LEVEL_ROWS;
+const int GameManager::LEVEL_COLS;
+
+// 构造函数：将头文件中的实现移到这里，纹理从异步加载器取走（加载失败时由加载器抛出异常）
+GameManager::GameManager(const std::vector<std::string>& levelPaths, const TextureManager& texManager, AssetLoader& assets,
+    const std::string& playerTexPath, int slimeCount, double pathSliceMicroseconds)
+    : texManager(texManager),
+    playerSprite(assets.takeTexture(playerTexPath)),
+    slimeSprite(assets.takeTexture(SLIME_TEX_PATH)),
+    levels(levelPaths, playerSprite.getFrameWidth(), playerSprite.getFrameHeight(), playerSprite.getFrameCols(),
+        LEVEL_ROWS, LEVEL_COLS),
+    session(&levels.current().getSession()),
+    slimeCount(slimeCount),
+    input(),
+    nextMazeCacheReady(false),
+    recording(false),
+    replayLog(nullptr),
+    replayFrame(0),
+    // 开始界面背景图
+    startBgTexture(assets.takeTexture(START_BG_PATH)),
+    showProfiler(false),
+    pathService(new PathService(levels.current().getMaze(), pathSliceMicroseconds > 0.0 ? 0 : 1)),
+    hintFrom({ -1, -1 }),
+    showHint(false),
+    pathSliceUs(pathSliceMicroseconds),
+    fov(new FieldOfView(levels.current().getMaze())),
+    showFog(false) {
+    session->setSlimes(slimeCount, SLIME_SEED);
+    mazeCache = MazeRenderer::bakeMaze(levels.current().getMaze(), texManager);
+}
+
+// 析构函数：释放背景图纹理和渲染缓存
 GameManager::~GameManager() {
     UnloadTexture(startBgTexture);
+    UnloadRenderTexture(mazeCache);
+    if (nextMazeCacheReady) UnloadRenderTexture(nextMazeCache);
+}
+
+// 从Raylib键盘状态采集输入
+InputState GameManager::pollInput() {
+    InputState state;
+    state.up = IsKeyDown(KEY_UP) || IsKeyDown(KEY_W);
+    state.down = IsKeyDown(KEY_DOWN) || IsKeyDown(KEY_S);
+    state.left = IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A);
+    state.right = IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D);
+    state.start = IsKeyPressed(KEY_SPACE);
+    state.reset = IsKeyPressed(KEY_R);
+    state.quit = IsKeyPressed(KEY_ESCAPE);
+    return state;
+}
+
+namespace {
+    // 计时辅助：返回两个时间点之间的毫秒数
+    double elapsedMs(std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end) {
+        return std::chrono::duration<double, std::milli>(end - begin).count();
+    }
 }
 
-// 루ֲ䣩
+// 开始录制（清空之前的录制内容）
+void GameManager::startRecording() {
+    recordLog.clear();
+    recording = true;
+}
+
+// 开始回放（从日志第0帧开始）
+void GameManager::startReplay(const InputLog& log) {
+    replayLog = &log;
+    replayFrame = 0;
+    frameTimings.clear();
+    frameTimings.reserve(log.size());
+}
+
+// 处理按键输入（回放时使用日志中的输入代替键盘）
 void GameManager::handleInput() {
-    switch (gameState) {
-    case GameState::START_SCREEN:
-        if (IsKeyPressed(KEY_SPACE)) {
-            gameState = GameState::PLAYING;
-        }
-        break;
-    case GameState::PLAYING:
-        if (IsKeyPressed(KEY_R)) {
-            player.reset(findStartPoint(maze));
-        }
-        break;
-    case GameState::WIN:
-    case GameState::GAME_OVER:
-        if (IsKeyPressed(KEY_R)) {
-            player.reset(findStartPoint(maze));
-            gameState = GameState::PLAYING;
-        }
-        if (IsKeyPressed(KEY_ESCAPE)) {
-            CloseWindow();
+    frameAllocs.beginFrame(); // handleInput是每帧第一步：在此结算上一帧的分配
+    PROFILE_SCOPE("input");
+    // F3：切换剖析叠加图（只影响显示，不进入对局输入和录制日志）
+    if (IsKeyPressed(KEY_F3)) {
+        showProfiler = !showProfiler;
+        if (showProfiler) Profiler::setEnabled(true);
+    }
+    // H：切换提示路径
+    if (IsKeyPressed(KEY_H)) {
+        showHint = !showHint;
+        if (!showHint) {
+            pathService->cancel(HINT_AGENT);
+            hintRequest.reset();
+            hintPath.clear();
+            hintFrom = { -1, -1 };
         }
-        break;
+    }
+    // F：切换战争迷雾（与提示路径一样只影响显示，不进入录制日志）
+    if (IsKeyPressed(KEY_F)) showFog = !showFog;
+
+    if (replayLog != nullptr) {
+        if (isReplayFinished()) return;
+        input = replayLog->inputAt(replayFrame);
+    }
+    else {
+        input = pollInput();
+    }
+    // 胜利界面按空格：换到下一关（已预加载好，只交换指针），新关卡随即收到同一个开始键进入游戏
+    if (input.start && session->getState() == GameState::WIN && levels.hasNext()) {
+        switchLevel();
+    }
+    session->handleInput(input);
+    if (session->isQuitRequested()) {
+        CloseWindow();
     }
 }
 
-// Ϸ״ֲ̬䣩
+// 更新游戏状态（固定步长推进；回放时使用日志中的帧间隔，保证确定性）
 void GameManager::update(float deltaTime) {
-    if (gameState != GameState::PLAYING) return;
+    PROFILE_SCOPE("update");
+    if (replayLog != nullptr) {
+        if (isReplayFinished()) return;
+        deltaTime = replayLog->frame(replayFrame).deltaTime;
+        ++replayFrame;
+    }
+    if (recording) {
+        recordLog.push(input, deltaTime);
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    session->advance(input, deltaTime);
+    auto end = std::chrono::steady_clock::now();
+    updateHint();
+    if (showFog && session->getState() == GameState::PLAYING) {
+        PROFILE_SCOPE("fov");
+        fov->update(session->getPlayer().getPosition());
+    }
+    prepareNextLevel();
+    if (watcher && watcher->poll()) reloadLevel();
+
+    if (replayLog != nullptr) {
+        frameTimings.push_back({ deltaTime, elapsedMs(begin, end), 0.0, 0 });
+    }
+}
+
+// 提示路径：玩家换格时提交新查询（同一agent的旧查询被取代），查询完成后再替换显示的路径，
+// 主循环只做原子读，不等待搜索（分帧模式下每帧最多花pathSliceUs）
+void GameManager::updateHint() {
+    pathService->pump(pathSliceUs); // 分帧模式下推进排队的查询（有工作线程时为空操作）
+    if (!showHint || session->getState() != GameState::PLAYING) return;
+
+    Point tile = session->getPlayer().getPosition();
+    if (!(tile == hintFrom)) {
+        hintFrom = tile;
+        const Level& level = levels.current();
+        // 与终点不在同一连通分量：必然无路，不必提交搜索
+        if (level.componentAt(tile) != level.componentAt(session->getEndPoint())) {
+            pathService->cancel(HINT_AGENT);
+            hintRequest.reset();
+            hintPath.clear();
+            return;
+        }
+        // 还没有提示路径（刚打开提示或刚换关）：先沿距离场给出步数最短路，搜索结果（按地形成本）到达后替换
+        if (hintPath.empty()) followExitField(level, tile, hintPath);
+        hintRequest = pathService->request(HINT_AGENT, tile, session->getEndPoint(), SearchAlgorithm::DIJKSTRA);
+    }
+    if (hintRequest && hintRequest->isDone()) {
+        if (hintRequest->isReady()) hintPath = hintRequest->getPath();
+        else if (hintRequest->getStatus() == PathRequest::Status::NO_PATH) hintPath.clear();
+        hintRequest.reset();
+    }
+}
 
-    player.update(maze, deltaTime);
+void GameManager::prepareNextLevel() {
+    if (nextMazeCacheReady) return;
+    const Level* next = levels.peekNext();
+    if (next == nullptr) return;
+    nextMazeCache = MazeRenderer::bakeMaze(next->getMaze(), texManager);
+    nextMazeCacheReady = true;
+}
+
+void GameManager::stopPathService() {
+    pathService.reset();
+    hintRequest.reset();
+    hintPath.clear();
+    hintFrom = { -1, -1 };
+}
+
+void GameManager::startPathService() {
+    pathService.reset(new PathService(levels.current().getMaze(), pathSliceUs > 0.0 ? 0 : 1));
+}
+
+// 切换关卡：寻路服务引用旧迷宫，须先停掉再交换关卡（旧关卡交给后台线程释放）
+void GameManager::switchLevel() {
+    stopPathService();
+    levels.advance();
+    Level& level = levels.current();
+    session = &level.getSession();
+    session->setSlimes(slimeCount, SLIME_SEED);
+    startPathService();
+    if (watcher) watcher.reset(new MazeWatcher(level.getFilePath()));
+    fov.reset(new FieldOfView(level.getMaze()));
+
+    // 预加载没赶上时advance已等到下一关，渲染缓存在这里补烘焙
+    RenderTexture2D cache = nextMazeCacheReady ? nextMazeCache : MazeRenderer::bakeMaze(level.getMaze(), texManager);
+    UnloadRenderTexture(mazeCache);
+    mazeCache = cache;
+    nextMazeCacheReady = false;
+    TraceLog(LOG_INFO, "Level %d/%d: %s (preprocess %.2f ms, waited %.2f ms)",
+        static_cast<int>(levels.getCurrentIndex() + 1), static_cast<int>(levels.getLevelCount()),
+        level.getFilePath().c_str(), level.getBuildMs(), levels.getLastWaitMs());
+}
+
+void GameManager::setHotReload(bool enabled) {
+    if (enabled) watcher.reset(new MazeWatcher(levels.current().getFilePath()));
+    else watcher.reset();
+}
+
+// 热重载：解析失败（如编辑器正写到一半）时保留当前关卡，等下一次保存
+void GameManager::reloadLevel() {
+    const std::string filePath = levels.current().getFilePath();
+    Maze edited;
+    try {
+        edited = MazeParser::loadFromFile(filePath);
+    }
+    catch (const std::runtime_error& e) {
+        TraceLog(LOG_WARNING, "Hot reload skipped: %s", e.what());
+        return;
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    stopPathService();
+    std::vector<CellChange> changes;
+    if (levels.current().applyEdit(edited, changes)) {
+        // 增量：迷宫与碰撞/寻路数据已就地更新，渲染缓存只重绘改动的格子
+        std::vector<Point> cells;
+        for (const CellChange& change : changes) {
+            cells.push_back(change.cell);
+            fov->setCell(change.cell.row, change.cell.col, change.after);
+        }
+        MazeRenderer::patchBaked(mazeCache, levels.current().getMaze(), texManager, cells);
+        startPathService();
+        TraceLog(LOG_INFO, "Hot reload: %d cells patched in %.2f ms", static_cast<int>(changes.size()),
+            elapsedMs(begin, std::chrono::steady_clock::now()));
+        return;
+    }
+
+    // 尺寸或起终点变了：整关重建，玩家回到新起点（已在游戏中则直接继续游戏）
+    GameState previous = session->getState();
+    try {
+        levels.reloadCurrent();
+    }
+    catch (const std::runtime_error& e) {
+        TraceLog(LOG_WARNING, "Hot reload skipped: %s", e.what());
+        startPathService();
+        return;
+    }
+    session = &levels.current().getSession();
+    session->setSlimes(slimeCount, SLIME_SEED);
+    if (previous != GameState::START_SCREEN) {
+        InputState startKey;
+        startKey.start = true;
+        session->handleInput(startKey);
+    }
+    startPathService();
+    fov.reset(new FieldOfView(levels.current().getMaze()));
+    UnloadRenderTexture(mazeCache);
+    mazeCache = MazeRenderer::bakeMaze(levels.current().getMaze(), texManager);
+    TraceLog(LOG_INFO, "Hot reload: level rebuilt in %.2f ms", elapsedMs(begin, std::chrono::steady_clock::now()));
+}
 
-    // ʤжŻǰԭ߼
-    Point playerPos = player.getPosition();
-    if (maze.mapData[playerPos.row][playerPos.col] == BlockType::END) {
-        gameState = GameState::WIN;
+// 输出逐帧耗时CSV
+void GameManager::writeFrameTimings(const std::string& filePath) const {
+    std::ofstream file(filePath);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open timing report: " + filePath);
+    }
+    file << "frame,deltaTime,updateMs,drawMs,allocations\n";
+    for (size_t i = 0; i < frameTimings.size(); ++i) {
+        const FrameTiming& t = frameTimings[i];
+        file << i << ',' << t.deltaTime << ',' << t.updateMs << ',' << t.drawMs << ',' << t.allocations << '\n';
     }
+}
 
-    // ʧжֲ䣩
-    if (player.getLavaStepCount() >= 2) {
-        gameState = GameState::GAME_OVER;
+// 绘制迷宫和角色（对局中、胜利、失败界面共用）
+void GameManager::drawWorld() const {
+    {
+        PROFILE_SCOPE("maze_draw");
+        MazeRenderer::drawBaked(mazeCache);
+        // 提示路径：在途经地块中央画小方块
+        for (const Point& p : hintPath) {
+            DrawRectangle(p.col * MazeRenderer::BLOCK_SIZE + MazeRenderer::BLOCK_SIZE / 2 - 4,
+                p.row * MazeRenderer::BLOCK_SIZE + MazeRenderer::BLOCK_SIZE / 2 - 4, 8, 8, Fade(SKYBLUE, 0.8f));
+        }
+        // 迷雾盖在地块和提示路径之上；史莱姆只画看得见的，玩家总在视野中心
+        if (showFog) MazeRenderer::drawFog(*fov);
     }
+    PROFILE_SCOPE("sprites");
+    slimeSprite.drawAll(session->getSlimes(), session->getInterpolationAlpha(), showFog ? fov.get() : nullptr);
+    playerSprite.draw(session->getPlayer(), session->getInterpolationAlpha());
+}
+
+// 绘制开始界面（背景图先画，文本在后）
+void GameManager::drawStartScreen(const Texture2D& background, const char* prompt) {
+    // 1. 获取屏幕中心坐标
+    int screenCenterX = GetScreenWidth() / 2;
+    int screenCenterY = GetScreenHeight() / 2;
+
+    // 绘制位置：X=0，Y=0（窗口左上角）
+    int bgX = 0;
+    int bgY = 0;
+    // 使用DrawTexturePro强制让背景图适配窗口尺寸（即使图片尺寸不对也能铺满）
+    Rectangle sourceRec = { 0.0f, 0.0f, (float)background.width, (float)background.height };
+    Rectangle destRec = { 0.0f, 0.0f, (float)GetScreenWidth(), (float)GetScreenHeight() };
+    DrawTexturePro(background, sourceRec, destRec, Vector2{ 0, 0 }, 0.0f, WHITE);
+
+    // ========== 然后绘制所有文本（文本会显示在背景图上方） ==========
+    // 2. 标题文本："MAZE GAME"（40号字体）
+    const char* titleText = "* MAZE GAME *";
+    int titleFontSize = 40;
+    // 计算文本宽度（关键：通过MeasureText获取文本实际宽度）
+    int titleWidth = MeasureText(titleText, titleFontSize);
+    // 计算文本左上角坐标（中心X - 文本宽度/2，垂直向上偏移50像素）
+    int titleX = screenCenterX - titleWidth / 2;
+    int titleY = screenCenterY - 90;
+    // 绘制标题（深蓝色，醒目）
+    DrawText(titleText, titleX, titleY, titleFontSize, DARKBLUE);
+
+    // 3. 开始提示："Press SPACE to Start"或加载进度（20号字体）
+    const char* startText = prompt;
+    int startFontSize = 20;
+    int startWidth = MeasureText(startText, startFontSize);
+    int startX = screenCenterX - startWidth / 2;
+    int startY = screenCenterY + 0; // 垂直向下偏移0像素
+    DrawText(startText, startX, startY, startFontSize, DARKGRAY);
+
+    // 4. 规则提示："Press R to Reset"（20号字体）
+    const char* ruleText = "~ Press R to Reset ~";
+    int ruleFontSize = 20;
+    int ruleWidth = MeasureText(ruleText, ruleFontSize);
+    int ruleX = screenCenterX - ruleWidth / 2;
+    int ruleY = screenCenterY + 40; // 垂直向下偏移40像素
+    DrawText(ruleText, ruleX, ruleY, ruleFontSize, DARKGRAY);
+
+    const char* ruleText1 = "!! Avoid Lava (2 steps = Game Over) !!";
+    int ruleFontSize1 = 20;
+    int ruleWidth1 = MeasureText(ruleText1, ruleFontSize1);
+    int ruleX1 = screenCenterX - ruleWidth1 / 2;
+    int ruleY1 = screenCenterY + 80; // 垂直向下偏移80像素
+    DrawText(ruleText1, ruleX1, ruleY1, ruleFontSize1, RED);
 }
 
-// Ϸݣ޸ģͼ˳ǰıں
+// 绘制游戏内容（核心修改：背景图绘制顺序提前，文本在后）
 void GameManager::draw() const {
+    auto drawBegin = std::chrono::steady_clock::now();
     BeginDrawing();
     ClearBackground(RAYWHITE);
 
-    switch (gameState) {
+    switch (session->getState()) {
     case GameState::START_SCREEN: {
-        // 1. ȡĻ
-        int screenCenterX = GetScreenWidth() / 2;
-        int screenCenterY = GetScreenHeight() / 2;
-
-        // λãX=0Y=0Ͻǣ
-        int bgX = 0;
-        int bgY = 0;
-        // ʹDrawTextureProǿñͼ䴰ڳߴ磨ʹͼƬߴ粻Ҳ
-        Rectangle sourceRec = { 0.0f, 0.0f, (float)startBgTexture.width, (float)startBgTexture.height };
-        Rectangle destRec = { 0.0f, 0.0f, (float)GetScreenWidth(), (float)GetScreenHeight() };
-        DrawTexturePro(startBgTexture, sourceRec, destRec, Vector2{ 0, 0 }, 0.0f, WHITE);
-
-        // ========== ȻııʾڱͼϷ ==========
-        // 2. ı"MAZE GAME"40壩
-        const char* titleText = "* MAZE GAME *";
-        int titleFontSize = 40;
-        // ıȣؼͨMeasureTextȡıʵʿȣ
-        int titleWidth = MeasureText(titleText, titleFontSize);
-        // ıϽ꣨X - ı/2ֱƫ50أ
-        int titleX = screenCenterX - titleWidth / 2;
-        int titleY = screenCenterY - 90;
-        // Ʊ⣨ɫĿ
-        DrawText(titleText, titleX, titleY, titleFontSize, DARKBLUE);
-
-        // 3. ʼʾ"Press SPACE to Start"20壩
-        const char* startText = "~ Press SPACE to Start ~";
-        int startFontSize = 20;
-        int startWidth = MeasureText(startText, startFontSize);
-        int startX = screenCenterX - startWidth / 2;
-        int startY = screenCenterY + 0; // ֱƫ0
-        DrawText(startText, startX, startY, startFontSize, DARKGRAY);
-
-        // 4. ʾ"Press R to Reset"20壩
-        const char* ruleText = "~ Press R to Reset ~";
-        int ruleFontSize = 20;
-        int ruleWidth = MeasureText(ruleText, ruleFontSize);
-        int ruleX = screenCenterX - ruleWidth / 2;
-        int ruleY = screenCenterY + 40; // ֱƫ40
-        DrawText(ruleText, ruleX, ruleY, ruleFontSize, DARKGRAY);
-
-        const char* ruleText1 = "!! Avoid Lava (2 steps = Game Over) !!";
-        int ruleFontSize1 = 20;
-        int ruleWidth1 = MeasureText(ruleText1, ruleFontSize1);
-        int ruleX1 = screenCenterX - ruleWidth1 / 2;
-        int ruleY1 = screenCenterY + 80; // ֱƫ80
-        DrawText(ruleText1, ruleX1, ruleY1, ruleFontSize1, RED);
-
+        PROFILE_SCOPE("ui_text");
+        drawStartScreen(startBgTexture, "~ Press SPACE to Start ~");
         break;
     }
 
     case GameState::PLAYING:
-        // Ʋ㼶Թ + Сˣֲ䣩
-        MazeRenderer::drawMaze(maze, texManager);
-        player.draw();
-        // UIʾֲ䣩
-        DrawText(("Lava Steps: " + std::to_string(player.getLavaStepCount()) + "/2").c_str(), 10, 8, 16, RED);
+        // 绘制层级：仅迷宫 + 小人（保持不变）
+        drawWorld();
+        // 简化UI提示（保持不变）
+        {
+            PROFILE_SCOPE("ui_text");
+            // TextFormat写入Raylib的静态缓冲，不产生堆分配
+            DrawText(TextFormat("Lava Steps: %d/2", session->getPlayer().getLavaStepCount()), 10, 8, 16, RED);
+        }
         //DrawText("WASD/Arrow Keys to Move", 10, 40, 14, GRAY);
         break;
 
-        // ޸WIN֧ϴţγɾֲ
+        // 核心修复：给WIN分支加上大括号，形成局部作用域
     case GameState::WIN: {
-        // ʤ棨ŻУ
-        MazeRenderer::drawMaze(maze, texManager);
-        player.draw();
-        // ͸αԭߴ磩
+        // 胜利界面（优化：字体居中）
+        drawWorld();
+        PROFILE_SCOPE("ui_text");
+        // 半透明矩形背景（保持原尺寸）
         int winRectX = GetScreenWidth() / 2 - 150;
         int winRectY = GetScreenHeight() / 2 - 80;
         int winRectWidth = 300;
         int winRectHeight = 160;
         DrawRectangle(winRectX, winRectY, winRectWidth, winRectHeight, Color{ 0, 255, 0, 180 });
 
-        // ģıУ
+        // 计算矩形中心（用于文本居中）
         int winRectCenterX = winRectX + winRectWidth / 2;
         int winRectCenterY = winRectY + winRectHeight / 2;
 
-        // 1. YOU WIN! ı
+        // 1. YOU WIN! 文本
         const char* winText = "YOU WIN!";
         int winFontSize = 32;
         int winTextWidth = MeasureText(winText, winFontSize);
@@ -156,7 +423,7 @@ void GameManager::draw() const {
         int winTextY = winRectCenterY - 45;
         DrawText(winText, winTextX, winTextY, winFontSize, WHITE);
 
-        // 2. Press R to Restart ı
+        // 2. Press R to Restart 文本
         const char* winRestartText = "Press R to Restart";
         int winRestartFontSize = 18;
         int winRestartWidth = MeasureText(winRestartText, winRestartFontSize);
@@ -164,50 +431,58 @@ void GameManager::draw() const {
         int winRestartY = winRectCenterY + 5;
         DrawText(winRestartText, winRestartX, winRestartY, winRestartFontSize, WHITE);
 
-        // 3. Press ESC to Exit ı
+        // 3. Press ESC to Exit 文本
         const char* winExitText = "Press ESC to Exit";
         int winExitFontSize = 18;
         int winExitWidth = MeasureText(winExitText, winExitFontSize);
         int winExitX = winRectCenterX - winExitWidth / 2;
         int winExitY = winRectCenterY + 35;
         DrawText(winExitText, winExitX, winExitY, winExitFontSize, WHITE);
+
+        // 4. 有下一关时提示按空格进入
+        if (levels.hasNext()) {
+            const char* winNextText = "Press SPACE for Next Level";
+            int winNextFontSize = 18;
+            int winNextWidth = MeasureText(winNextText, winNextFontSize);
+            DrawText(winNextText, winRectCenterX - winNextWidth / 2, winRectCenterY + 58, winNextFontSize, WHITE);
+        }
         break;
     }
 
     case GameState::GAME_OVER: {
-        // ʧܽ棨޸ģУ
-        MazeRenderer::drawMaze(maze, texManager);
-        player.draw();
-        // ͸ɫαԭߴ磩
+        // 失败界面（核心修改：字体居中）
+        drawWorld();
+        PROFILE_SCOPE("ui_text");
+        // 半透明红色矩形背景（保持原尺寸）
         int gameOverRectX = GetScreenWidth() / 2 - 150;
         int gameOverRectY = GetScreenHeight() / 2 - 80;
         int gameOverRectWidth = 300;
         int gameOverRectHeight = 160;
         DrawRectangle(gameOverRectX, gameOverRectY, gameOverRectWidth, gameOverRectHeight, Color{ 255, 0, 0, 180 });
 
-        // ģıУؼ
+        // 计算矩形中心（用于文本居中，关键！）
         int gameOverRectCenterX = gameOverRectX + gameOverRectWidth / 2;
         int gameOverRectCenterY = gameOverRectY + gameOverRectHeight / 2;
 
-        // 1. GAME OVER ı
+        // 1. GAME OVER 文本
         const char* gameOverText = "GAME OVER";
         int gameOverFontSize = 32;
-        // ı
+        // 计算文本宽度
         int gameOverTextWidth = MeasureText(gameOverText, gameOverFontSize);
-        // м㣺X - ı/2
+        // 居中计算：矩形中心X - 文本宽度/2
         int gameOverTextX = gameOverRectCenterX - gameOverTextWidth / 2;
         int gameOverTextY = gameOverRectCenterY - 40;
         DrawText(gameOverText, gameOverTextX, gameOverTextY, gameOverFontSize, WHITE);
 
-        // 2. Too Many Lava Steps! ı
-        const char* lavaText = "Too Many Lava Steps!";
+        // 2. Too Many Lava Steps! 文本
+        const char* lavaText = session->isCaughtBySlime() ? "Caught by a Slime!" : "Too Many Lava Steps!";
         int lavaFontSize = 18;
         int lavaTextWidth = MeasureText(lavaText, lavaFontSize);
         int lavaTextX = gameOverRectCenterX - lavaTextWidth / 2;
         int lavaTextY = gameOverRectCenterY + 10;
         DrawText(lavaText, lavaTextX, lavaTextY, lavaFontSize, WHITE);
 
-        // 3. Press R to Restart ı
+        // 3. Press R to Restart 文本
         const char* restartText = "Press R to Restart";
         int restartFontSize = 18;
         int restartTextWidth = MeasureText(restartText, restartFontSize);
@@ -218,5 +493,18 @@ void GameManager::draw() const {
     }
     }
 
-    EndDrawing();
+    if (showProfiler) {
+        profilerOverlay.draw(10, GetScreenHeight() - 110, frameAllocs);
+    }
+
+    {
+        PROFILE_SCOPE("end_drawing");
+        EndDrawing();
+    }
+
+    // 回放时记录本帧绘制耗时（对应update中刚记录的一帧）
+    if (replayLog != nullptr && !frameTimings.empty() && frameTimings.size() == replayFrame) {
+        frameTimings.back().drawMs = elapsedMs(drawBegin, std::chrono::steady_clock::now());
+        frameTimings.back().allocations = frameAllocs.getCurrentFrameAllocations();
+    }
 }
\ No newline at end of file
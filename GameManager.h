@@ -1,52 +1,140 @@
 #ifndef GAME_MANAGER_H
 #define GAME_MANAGER_H
 #include "MazeParser.h"
-#include "Player.h"
-#include "PathFinder.h"
+#include "GameSession.h"
+#include "PlayerSprite.h"
+#include "SlimeSprite.h"
 #include "TextureManager.h"
 #include "MazeRenderer.h"
-#include "raylib.h" // ҪraylibͷļʹTexture2D
-
-enum class GameState {
-    START_SCREEN,  // ʼ
-    PLAYING,       // Ϸ
-    WIN,           // ʤ
-    GAME_OVER      // Ϸʧ
-};
+#include "InputLog.h"
+#include "ProfilerOverlay.h"
+#include "PathService.h"
+#include "AssetLoader.h"
+#include "LevelManager.h"
+#include "MazeWatcher.h"
+#include "AllocTracker.h"
+#include "FieldOfView.h"
+#include <memory>
+#include "raylib.h" // 新增：需要包含raylib头文件以使用Texture2D
 
+// 游戏管理类（Raylib前端：采集键盘输入交给GameSession，并负责绘制）
 class GameManager {
 public:
-    // 캯ֲ䣩
-    GameManager(const Maze& maze, const TextureManager& texManager, const std::string& playerTexPath);
+    // 开始界面背景图、史莱姆纹理路径（启动时先行提交给AssetLoader）
+    static const char* const START_BG_PATH;
+    static const char* const SLIME_TEX_PATH;
+    // 任务要求的关卡尺寸（窗口640×640正好20×20格），每一关都须满足，否则按非法关卡抛出异常
+    static const int LEVEL_ROWS = 20;
+    static const int LEVEL_COLS = 20;
+
+    // 构造函数声明（levelPaths：关卡文件列表，胜利后按空格进入下一关；小人、史莱姆和背景纹理从assets取走；
+    // slimeCount：史莱姆数量，0表示不生成；pathSliceMicroseconds > 0 时寻路不用工作线程，改为每帧在该预算内分帧推进）
+    GameManager(const std::vector<std::string>& levelPaths, const TextureManager& texManager, AssetLoader& assets,
+        const std::string& playerTexPath, int slimeCount = 0, double pathSliceMicroseconds = 0.0);
 
-    // 
+    // 新增：析构函数声明
     ~GameManager();
 
-    // 루߼䣩
+    // 处理输入（采集键盘状态，功能键交给对局逻辑）
     void handleInput();
-    // Ϸ״̬߼䣩
+    // 更新游戏状态（使用本帧采集的输入，按固定步长推进逻辑）
     void update(float deltaTime);
-    // Ϸݣ߼䣩
+    // 绘制游戏内容（逻辑不变）
     void draw() const;
 
+    // 录制：开始逐帧记录输入和帧间隔
+    void startRecording();
+    const InputLog& getRecording() const { return recordLog; }
+
+    // 回放：按日志逐帧注入输入和帧间隔（日志需在回放期间保持有效）
+    void startReplay(const InputLog& log);
+    bool isReplaying() const { return replayLog != nullptr; }
+    bool isReplayFinished() const { return replayLog != nullptr && replayFrame >= replayLog->size(); }
+
+    // 单帧耗时（回放时逐帧统计，用于性能回归对比）
+    struct FrameTiming {
+        float deltaTime;   // 本帧逻辑帧间隔（秒）
+        double updateMs;   // update耗时（毫秒）
+        double drawMs;     // draw耗时（毫秒，含EndDrawing）
+        uint64_t allocations; // 本帧主线程堆分配次数（未链接分配钩子时为0）
+    };
+    const std::vector<FrameTiming>& getFrameTimings() const { return frameTimings; }
+    // 输出逐帧耗时CSV（失败时抛出异常）
+    void writeFrameTimings(const std::string& filePath) const;
+
+    // 逐帧分配统计（handleInput开头结算上一帧；需链接AllocHooks.cpp才有数据）
+    const FrameAllocCounter& getFrameAllocs() const { return frameAllocs; }
+
+    // 当前关卡
+    const Level& getLevel() const { return levels.current(); }
+
+    // 热重载：监视当前关卡文件，改动后只把变化的格子同步到渲染缓存、碰撞结构和寻路数据
+    void setHotReload(bool enabled);
+
+    // 战争迷雾（F切换）：只显示玩家视线内的格子，走过看到的格子变暗保留
+    void setFogOfWar(bool enabled) { showFog = enabled; }
+
+    // 绘制开始界面（背景图+标题+提示文字；启动加载期间也用它，prompt换成加载进度）
+    static void drawStartScreen(const Texture2D& background, const char* prompt);
+
 private:
-    const Maze& maze;
     const TextureManager& texManager;
-    Player player;
-    PathFinder pathFinder;
-    GameState gameState;
-    Texture2D startBgTexture; // 洢ͼ
-
-    // Թ㣨߼䣩
-    Point findStartPoint(const Maze& maze) const {
-        for (int row = 0; row < maze.rows; ++row) {
-            for (int col = 0; col < maze.cols; ++col) {
-                if (maze.mapData[row][col] == BlockType::START) {
-                    return { row, col };
-                }
-            }
-        }
-        throw std::runtime_error("Start point not found in maze!");
-    }
+    PlayerSprite playerSprite;  // 玩家精灵图（需先于levels构造，提供关键帧尺寸）
+    SlimeSprite slimeSprite;    // 史莱姆共享纹理
+    LevelManager levels;        // 关卡（当前关游玩时后台预加载下一关）
+    GameSession* session;       // 当前关卡的无头对局逻辑（切换关卡时改指向新关卡）
+    int slimeCount;
+    InputState input;           // 本帧输入
+
+    // 迷宫渲染缓存：当前关卡的，以及下一关预加载完成后提前烘焙的（切换时直接交换）
+    RenderTexture2D mazeCache;
+    RenderTexture2D nextMazeCache;
+    bool nextMazeCacheReady;
+
+    // 录制/回放状态
+    bool recording;                         // 是否正在录制
+    InputLog recordLog;                     // 录制中的日志
+    const InputLog* replayLog;              // 正在回放的日志（空表示未回放）
+    size_t replayFrame;                     // 回放进度（下一帧序号）
+    mutable std::vector<FrameTiming> frameTimings; // 逐帧耗时（draw为const，需mutable）
+    Texture2D startBgTexture; // 存储背景图纹理
+    bool showProfiler;                      // 是否显示剖析叠加图（F3切换）
+    mutable ProfilerOverlay profilerOverlay; // 剖析叠加图（draw为const，需mutable）
+    FrameAllocCounter frameAllocs;          // 逐帧堆分配计数（稳态帧应为0）
+
+    // 提示路径（H切换）：玩家换格时向寻路服务提交查询，搜索在工作线程进行，每帧只轮询句柄
+    std::unique_ptr<PathService> pathService;  // 引用当前关卡的迷宫，切换关卡/热重载时重建
+    PathHandle hintRequest;                 // 进行中的提示查询（空表示没有）
+    std::vector<Point> hintPath;            // 当前显示的提示路径
+    Point hintFrom;                         // 上次提交查询时玩家所在格
+    bool showHint;
+    double pathSliceUs;                     // 分帧寻路的每帧预算（微秒，0表示使用工作线程）
+    static const int HINT_AGENT = 0;        // 提示路径在寻路服务中的agent编号
+
+    std::unique_ptr<MazeWatcher> watcher;   // 当前关卡文件监视（未开启热重载时为空）
+
+    // 战争迷雾：视野只在玩家换格时重算（开启迷雾前也不计算），换关/整关重建时重建
+    std::unique_ptr<FieldOfView> fov;
+    bool showFog;
+
+    // 提交/轮询提示路径查询
+    void updateHint();
+
+    // 下一关预加载完成后烘焙其渲染缓存（每帧检查一次）
+    void prepareNextLevel();
+    // 切换到下一关：交换关卡、渲染缓存，重建寻路服务
+    void switchLevel();
+    // 热重载当前关卡文件（能增量则只同步改动的格子，否则整关重建）
+    void reloadLevel();
+    // 停止寻路服务并清空提示路径（服务的工作线程读着迷宫，换关或改迷宫前必须先停）
+    void stopPathService();
+    // 为当前关卡重建寻路服务
+    void startPathService();
+
+    // 绘制迷宫、史莱姆和玩家
+    void drawWorld() const;
+
+    // 从Raylib键盘状态采集输入
+    static InputState pollInput();
 };
 #endif // GAME_MANAGER_H
\ No newline at end of file
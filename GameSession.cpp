@@ -0,0 +1,135 @@
+#include "GameSession.h"
+#include "Profiler.h"
+
+// 构造：校验迷宫起终点（PathFinder构造时检查），构建碰撞加速结构，在起点生成玩家
+GameSession::GameSession(const Maze& maze, int playerFrameWidth, int playerFrameHeight, int playerFrameCols)
+    : maze(maze),
+    pathFinder(maze),
+    collision(maze),
+    player(findStartPoint(maze), playerFrameWidth, playerFrameHeight, playerFrameCols),
+    gameState(GameState::START_SCREEN),
+    quitRequested(false),
+    accumulator(0.0f),
+    slimeCount(0),
+    slimeSeed(0),
+    slimeTarget(SlimeTarget::PLAYER),
+    caughtBySlime(false) {
+}
+
+constexpr float GameSession::FIXED_STEP;
+constexpr float GameSession::SLIME_CATCH_RADIUS;
+
+// 配置史莱姆并立即生成
+void GameSession::setSlimes(int count, unsigned seed, SlimeTarget target) {
+    slimeCount = count;
+    slimeSeed = seed;
+    slimeTarget = target;
+    slimes.clear();
+    if (slimeCount > 0) {
+        slimeField.build(collision, slimeTargetPoint());
+        slimes.spawn(collision, slimeField, slimeCount, slimeSeed);
+    }
+}
+
+// 同步墙体改动（迷宫由调用方就地修改，这里只更新派生的加速结构）
+void GameSession::refreshWalls(const std::vector<Point>& cells) {
+    for (const Point& p : cells) {
+        collision.setWall(p.row, p.col, maze.mapData[p.row][p.col] == BlockType::WALL);
+    }
+    if (slimeField.isBuilt()) {
+        slimeField.updateWalls(collision, cells);
+    }
+}
+
+// 流场目标格
+Point GameSession::slimeTargetPoint() const {
+    return slimeTarget == SlimeTarget::PLAYER ? player.getPosition() : pathFinder.getEndPoint();
+}
+
+// 重新开局
+void GameSession::restart() {
+    player.reset(findStartPoint(maze));
+    caughtBySlime = false;
+    setSlimes(slimeCount, slimeSeed, slimeTarget);
+}
+
+// 处理功能键输入
+void GameSession::handleInput(const InputState& input) {
+    switch (gameState) {
+    case GameState::START_SCREEN:
+        if (input.start) {
+            gameState = GameState::PLAYING;
+        }
+        break;
+    case GameState::PLAYING:
+        if (input.reset) {
+            restart();
+        }
+        break;
+    case GameState::WIN:
+    case GameState::GAME_OVER:
+        if (input.reset) {
+            restart();
+            gameState = GameState::PLAYING;
+        }
+        if (input.quit) {
+            quitRequested = true;
+        }
+        break;
+    }
+}
+
+// 更新游戏状态
+void GameSession::update(const InputState& input, float deltaTime) {
+    if (gameState != GameState::PLAYING) return;
+
+    player.update(maze, collision, input, deltaTime);
+
+    // 胜利判定
+    Point playerPos = player.getPosition();
+    if (maze.mapData[playerPos.row][playerPos.col] == BlockType::END) {
+        gameState = GameState::WIN;
+    }
+
+    // 失败判定
+    if (player.getLavaStepCount() >= 2) {
+        gameState = GameState::GAME_OVER;
+    }
+
+    // 史莱姆：玩家换格时重建流场，批量移动后检查是否抓住玩家
+    if (slimes.size() > 0 && gameState == GameState::PLAYING) {
+        PROFILE_SCOPE("slimes");
+        if (!(slimeTargetPoint() == slimeField.getTarget())) {
+            slimeField.build(collision, slimeTargetPoint());
+        }
+        slimes.update(collision, slimeField, deltaTime);
+
+        Vec2 foot = player.getFootCenter();
+        if (slimes.anyWithin(foot.x, foot.y, SLIME_CATCH_RADIUS)) {
+            caughtBySlime = true;
+            gameState = GameState::GAME_OVER;
+        }
+    }
+}
+
+// 固定步长推进：逻辑成本只取决于经过的时间，长帧也不会一次移动过远
+int GameSession::advance(const InputState& input, float frameTime) {
+    if (gameState != GameState::PLAYING) {
+        accumulator = 0.0f;
+        return 0;
+    }
+
+    accumulator += frameTime;
+    int steps = 0;
+    while (accumulator >= FIXED_STEP && steps < MAX_CATCH_UP_STEPS && gameState == GameState::PLAYING) {
+        update(input, FIXED_STEP);
+        accumulator -= FIXED_STEP;
+        ++steps;
+    }
+
+    // 追赶上限已到或对局结束：丢弃剩余时间，避免下一帧继续积压
+    if (accumulator >= FIXED_STEP || gameState != GameState::PLAYING) {
+        accumulator = 0.0f;
+    }
+    return steps;
+}
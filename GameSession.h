@@ -0,0 +1,98 @@
+#ifndef GAME_SESSION_H
+#define GAME_SESSION_H
+#include "MazeParser.h"
+#include "PathFinder.h"
+#include "Player.h"
+#include "CollisionMap.h"
+#include "FlowField.h"
+#include "SlimeSwarm.h"
+#include "GameTypes.h"
+
+enum class GameState {
+    START_SCREEN,  // 开始界面
+    PLAYING,       // 游戏中
+    WIN,           // 胜利
+    GAME_OVER      // 游戏失败
+};
+
+// 史莱姆追踪目标
+enum class SlimeTarget {
+    PLAYER,  // 追玩家（玩家换格时重建流场）
+    EXIT     // 涌向终点（流场只建一次）
+};
+
+// 对局逻辑类（无头核心：状态切换、玩家更新、胜负判定，不依赖Raylib）
+class GameSession {
+public:
+    // 构造：传入迷宫和玩家关键帧尺寸（无头模拟可使用默认尺寸）
+    GameSession(const Maze& maze, int playerFrameWidth = PLAYER_FRAME_WIDTH,
+        int playerFrameHeight = PLAYER_FRAME_HEIGHT, int playerFrameCols = 3);
+
+    // 配置史莱姆：每次开局/重置时用固定种子生成count个（0表示不生成）
+    void setSlimes(int count, unsigned seed, SlimeTarget target = SlimeTarget::PLAYER);
+
+    // 热重载：迷宫中这些格子的墙体状态已被改写，增量同步碰撞结构和史莱姆流场
+    void refreshWalls(const std::vector<Point>& cells);
+
+    // 处理功能键（开始/重置/退出）
+    void handleInput(const InputState& input);
+    // 更新对局：移动玩家并判定胜负（单个逻辑步）
+    void update(const InputState& input, float deltaTime);
+    // 按固定步长推进：累积真实帧间隔，最多追赶MAX_CATCH_UP_STEPS步，返回本帧执行的逻辑步数
+    int advance(const InputState& input, float frameTime);
+    // 渲染插值系数（0~1：累积器中未消耗的时间占一个逻辑步的比例；对局结束后固定为1）
+    float getInterpolationAlpha() const {
+        return gameState == GameState::PLAYING ? accumulator / FIXED_STEP : 1.0f;
+    }
+
+    GameState getState() const { return gameState; }
+    const Player& getPlayer() const { return player; }
+    const Maze& getMaze() const { return maze; }
+    const CollisionMap& getCollisionMap() const { return collision; }
+    const SlimeSwarm& getSlimes() const { return slimes; }
+    const Point& getEndPoint() const { return pathFinder.getEndPoint(); }
+    // 本局是否因被史莱姆抓住而失败
+    bool isCaughtBySlime() const { return caughtBySlime; }
+    // 是否请求退出（结算界面按ESC）
+    bool isQuitRequested() const { return quitRequested; }
+
+    static constexpr float FIXED_STEP = 1.0f / 120.0f; // 逻辑步长（120Hz，与显示帧率解耦）
+    static const int MAX_CATCH_UP_STEPS = 8;           // 单帧最多追赶的逻辑步数（防止卡顿后雪崩）
+    static constexpr float SLIME_CATCH_RADIUS = 12.0f; // 史莱姆中心与玩家脚部中心小于该距离即被抓住
+
+private:
+    const Maze& maze;
+    PathFinder pathFinder;
+    CollisionMap collision;     // 碰撞加速结构（墙体位图+距墙距离场）
+    Player player;
+    GameState gameState;
+    bool quitRequested;
+    float accumulator;          // 尚未消耗的帧时间（秒）
+
+    // 史莱姆NPC
+    SlimeSwarm slimes;
+    FlowField slimeField;       // 所有史莱姆共享的流场
+    int slimeCount;
+    unsigned slimeSeed;
+    SlimeTarget slimeTarget;
+    bool caughtBySlime;
+
+    // 重新开局：玩家回到起点，史莱姆按种子重新生成
+    void restart();
+    // 流场目标格（玩家所在格或终点）
+    Point slimeTargetPoint() const;
+
+    // 查找迷宫起点
+    static Point findStartPoint(const Maze& maze) {
+        for (int row = 0; row < maze.rows; ++row) {
+            for (int col = 0; col < maze.cols; ++col) {
+                if (maze.mapData[row][col] == BlockType::START) {
+                    return { row, col };
+                }
+            }
+        }
+        throw std::runtime_error("Start point not found in maze!");
+    }
+};
+
+#endif // GAME_SESSION_H
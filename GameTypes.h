@@ -0,0 +1,34 @@
+#ifndef GAME_TYPES_H
+#define GAME_TYPES_H
+
+// 无头核心使用的基础类型（不依赖Raylib，前端负责与Raylib类型互转）
+
+// 单个地块的逻辑像素尺寸（32×32，渲染层MazeRenderer::BLOCK_SIZE与之一致）
+const int TILE_SIZE = 32;
+
+// 默认角色关键帧尺寸（character.png为144×192，3列4行 → 48×48），无头模拟时使用
+const int PLAYER_FRAME_WIDTH = 48;
+const int PLAYER_FRAME_HEIGHT = 48;
+
+// 二维浮点向量（替代Raylib的Vector2）
+struct Vec2 {
+    float x;
+    float y;
+};
+
+// 单帧输入状态（前端采集键盘，模拟/回放时可直接构造）
+struct InputState {
+    // 持续按下的移动键
+    bool up = false;
+    bool down = false;
+    bool left = false;
+    bool right = false;
+    // 本帧刚按下的功能键
+    bool start = false;  // 空格：开始游戏
+    bool reset = false;  // R：重置/重新开始
+    bool quit = false;   // ESC：退出
+
+    bool hasMove() const { return up || down || left || right; }
+};
+
+#endif // GAME_TYPES_H
@@ -0,0 +1,115 @@
+#include "GridCollision.h"
+#include <cmath>
+#include <algorithm>
+
+namespace {
+    // 包围盒在某一轴上覆盖的格子区间 [first, last]（右/下边界为开区间）
+    void coveredCells(float start, float length, int& first, int& last) {
+        first = static_cast<int>(std::floor(start / TILE_SIZE));
+        last = static_cast<int>(std::ceil((start + length) / TILE_SIZE)) - 1;
+        if (last < first) last = first;
+    }
+
+    // 某一列在行区间内是否有墙
+    bool columnBlocked(const CollisionMap& collision, int col, int firstRow, int lastRow) {
+        for (int row = firstRow; row <= lastRow; ++row) {
+            if (collision.isWall(row, col)) return true;
+        }
+        return false;
+    }
+
+    // 某一行在列区间内是否有墙
+    bool rowBlocked(const CollisionMap& collision, int row, int firstCol, int lastCol) {
+        for (int col = firstCol; col <= lastCol; ++col) {
+            if (collision.isWall(row, col)) return true;
+        }
+        return false;
+    }
+}
+
+// 沿X轴扫掠
+float GridCollision::sweepX(const CollisionMap& collision, const Aabb& box, float dx) {
+    if (dx == 0.0f) return 0.0f;
+
+    int firstRow, lastRow;
+    coveredCells(box.y, box.height, firstRow, lastRow);
+
+    if (dx > 0) {
+        // 向右：从右边界所在格子的下一列开始，逐列检查直到目标右边界
+        float right = box.x + box.width;
+        float target = right + dx;
+        for (int col = static_cast<int>(std::ceil(right / TILE_SIZE)); col * TILE_SIZE < target; ++col) {
+            if (columnBlocked(collision, col, firstRow, lastRow)) {
+                return col * TILE_SIZE - right; // 停在墙格左边界
+            }
+        }
+    }
+    else {
+        // 向左：从左边界所在格子的上一列开始，逐列检查直到目标左边界
+        float left = box.x;
+        float target = left + dx;
+        for (int col = static_cast<int>(std::floor(left / TILE_SIZE)) - 1; (col + 1) * TILE_SIZE > target; --col) {
+            if (columnBlocked(collision, col, firstRow, lastRow)) {
+                return (col + 1) * TILE_SIZE - left; // 停在墙格右边界
+            }
+        }
+    }
+    return dx;
+}
+
+// 沿Y轴扫掠
+float GridCollision::sweepY(const CollisionMap& collision, const Aabb& box, float dy) {
+    if (dy == 0.0f) return 0.0f;
+
+    int firstCol, lastCol;
+    coveredCells(box.x, box.width, firstCol, lastCol);
+
+    if (dy > 0) {
+        // 向下：逐行检查直到目标下边界
+        float bottom = box.y + box.height;
+        float target = bottom + dy;
+        for (int row = static_cast<int>(std::ceil(bottom / TILE_SIZE)); row * TILE_SIZE < target; ++row) {
+            if (rowBlocked(collision, row, firstCol, lastCol)) {
+                return row * TILE_SIZE - bottom; // 停在墙格上边界
+            }
+        }
+    }
+    else {
+        // 向上：逐行检查直到目标上边界
+        float top = box.y;
+        float target = top + dy;
+        for (int row = static_cast<int>(std::floor(top / TILE_SIZE)) - 1; (row + 1) * TILE_SIZE > target; --row) {
+            if (rowBlocked(collision, row, firstCol, lastCol)) {
+                return (row + 1) * TILE_SIZE - top; // 停在墙格下边界
+            }
+        }
+    }
+    return dy;
+}
+
+// 分轴移动（先X后Y），实现贴墙滑动
+Vec2 GridCollision::move(const CollisionMap& collision, const Aabb& box, Vec2 delta) {
+    // 快速路径：起止包围盒覆盖的格子都在最近墙格的距离之内，整段位移直接放行
+    // （先查中心格距离：贴墙走廊中距离为1，立即退回扫掠，不做多余计算）
+    if (collision.hasDistanceField()) {
+        int centerRow = static_cast<int>(std::floor((box.y + box.height / 2) / TILE_SIZE));
+        int centerCol = static_cast<int>(std::floor((box.x + box.width / 2) / TILE_SIZE));
+        int clearance = collision.distanceToWall(centerRow, centerCol);
+        if (clearance > 1) {
+            int firstRow, lastRow, firstCol, lastCol;
+            coveredCells(std::min(box.y, box.y + delta.y), box.height + std::fabs(delta.y), firstRow, lastRow);
+            coveredCells(std::min(box.x, box.x + delta.x), box.width + std::fabs(delta.x), firstCol, lastCol);
+            int reach = std::max(std::max(centerRow - firstRow, lastRow - centerRow),
+                std::max(centerCol - firstCol, lastCol - centerCol));
+            if (reach < clearance) {
+                return delta;
+            }
+        }
+    }
+
+    Vec2 moved;
+    moved.x = sweepX(collision, box, delta.x);
+    Aabb shifted = { box.x + moved.x, box.y, box.width, box.height };
+    moved.y = sweepY(collision, shifted, delta.y);
+    return moved;
+}
@@ -0,0 +1,28 @@
+#ifndef GRID_COLLISION_H
+#define GRID_COLLISION_H
+#include "CollisionMap.h"
+#include "GameTypes.h"
+
+// 轴对齐包围盒（像素坐标，左上角+宽高）
+struct Aabb {
+    float x;
+    float y;
+    float width;
+    float height;
+};
+
+// 网格扫掠碰撞（无头核心）：包围盒沿单轴移动时逐列/逐行步进（DDA），
+// 在第一个墙格边界处停下；先X后Y分轴求解即可贴墙滑动。
+// 开销只与跨越的格子数有关，与速度无关，高速移动也不会穿墙。
+// 墙体查询走CollisionMap位图；有距离场时，远离墙体的移动一次查表直接放行。
+class GridCollision {
+public:
+    // 沿X轴扫掠：返回实际可移动的距离（与dx同号，绝对值不超过|dx|）
+    static float sweepX(const CollisionMap& collision, const Aabb& box, float dx);
+    // 沿Y轴扫掠：返回实际可移动的距离
+    static float sweepY(const CollisionMap& collision, const Aabb& box, float dy);
+    // 分轴移动：先X后Y，返回实际位移（被墙挡住的分量会被截断，另一分量继续滑动）
+    static Vec2 move(const CollisionMap& collision, const Aabb& box, Vec2 delta);
+};
+
+#endif // GRID_COLLISION_H
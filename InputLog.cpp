@@ -0,0 +1,117 @@
+#include "InputLog.h"
+#include <fstream>
+#include <cstring>
+
+namespace {
+    const char LOG_MAGIC[4] = { 'M', 'Z', 'I', 'N' };
+    const uint32_t LOG_VERSION = 1;
+
+    // 按键位定义
+    enum KeyBit : uint8_t {
+        KEY_BIT_UP = 1 << 0,
+        KEY_BIT_DOWN = 1 << 1,
+        KEY_BIT_LEFT = 1 << 2,
+        KEY_BIT_RIGHT = 1 << 3,
+        KEY_BIT_START = 1 << 4,
+        KEY_BIT_RESET = 1 << 5,
+        KEY_BIT_QUIT = 1 << 6
+    };
+
+    // 按小端字节序写入/读取（保证日志跨平台一致）
+    void writeU32(std::ofstream& out, uint32_t value) {
+        char bytes[4] = {
+            static_cast<char>(value & 0xFF), static_cast<char>((value >> 8) & 0xFF),
+            static_cast<char>((value >> 16) & 0xFF), static_cast<char>((value >> 24) & 0xFF)
+        };
+        out.write(bytes, 4);
+    }
+
+    uint32_t readU32(std::ifstream& in) {
+        unsigned char bytes[4] = { 0, 0, 0, 0 };
+        in.read(reinterpret_cast<char*>(bytes), 4);
+        return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+    }
+}
+
+// InputState → 位掩码
+uint8_t InputLog::packInput(const InputState& input) {
+    uint8_t keys = 0;
+    if (input.up)    keys |= KEY_BIT_UP;
+    if (input.down)  keys |= KEY_BIT_DOWN;
+    if (input.left)  keys |= KEY_BIT_LEFT;
+    if (input.right) keys |= KEY_BIT_RIGHT;
+    if (input.start) keys |= KEY_BIT_START;
+    if (input.reset) keys |= KEY_BIT_RESET;
+    if (input.quit)  keys |= KEY_BIT_QUIT;
+    return keys;
+}
+
+// 位掩码 → InputState
+InputState InputLog::unpackInput(uint8_t keys) {
+    InputState input;
+    input.up = (keys & KEY_BIT_UP) != 0;
+    input.down = (keys & KEY_BIT_DOWN) != 0;
+    input.left = (keys & KEY_BIT_LEFT) != 0;
+    input.right = (keys & KEY_BIT_RIGHT) != 0;
+    input.start = (keys & KEY_BIT_START) != 0;
+    input.reset = (keys & KEY_BIT_RESET) != 0;
+    input.quit = (keys & KEY_BIT_QUIT) != 0;
+    return input;
+}
+
+// 保存日志到二进制文件
+void InputLog::saveToFile(const std::string& filePath) const {
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open input log for writing: " + filePath);
+    }
+
+    file.write(LOG_MAGIC, 4);
+    writeU32(file, LOG_VERSION);
+    writeU32(file, static_cast<uint32_t>(frames.size()));
+    for (const auto& f : frames) {
+        // 帧间隔按位写入，保证回放时与录制完全一致
+        uint32_t dtBits;
+        static_assert(sizeof(dtBits) == sizeof(f.deltaTime), "float must be 32-bit");
+        std::memcpy(&dtBits, &f.deltaTime, sizeof(dtBits));
+        file.put(static_cast<char>(f.keys));
+        writeU32(file, dtBits);
+    }
+
+    if (!file) {
+        throw std::runtime_error("Failed to write input log: " + filePath);
+    }
+}
+
+// 从二进制文件加载日志
+InputLog InputLog::loadFromFile(const std::string& filePath) {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open input log: " + filePath);
+    }
+
+    char magic[4] = { 0, 0, 0, 0 };
+    file.read(magic, 4);
+    if (!file || std::memcmp(magic, LOG_MAGIC, 4) != 0) {
+        throw std::runtime_error("Not an input log file: " + filePath);
+    }
+    uint32_t version = readU32(file);
+    if (version != LOG_VERSION) {
+        throw std::runtime_error("Unsupported input log version: " + std::to_string(version));
+    }
+
+    InputLog log;
+    uint32_t count = readU32(file);
+    log.frames.reserve(count < (1u << 20) ? count : (1u << 20)); // 防止损坏文件导致超大分配
+    for (uint32_t i = 0; i < count; ++i) {
+        Frame f;
+        f.keys = static_cast<uint8_t>(file.get());
+        uint32_t dtBits = readU32(file);
+        std::memcpy(&f.deltaTime, &dtBits, sizeof(dtBits));
+        if (!file) {
+            throw std::runtime_error("Input log truncated at frame " + std::to_string(i) + ": " + filePath);
+        }
+        log.frames.push_back(f);
+    }
+    return log;
+}
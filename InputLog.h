@@ -0,0 +1,42 @@
+#ifndef INPUT_LOG_H
+#define INPUT_LOG_H
+#include "GameTypes.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+// 输入录制日志（逐帧记录输入+帧间隔，用于确定性回放和性能回归测试）
+// 二进制格式：魔数"MZIN" + 版本号(uint32) + 帧数(uint32) + 每帧[按键位掩码(uint8) + 帧间隔(float)]
+class InputLog {
+public:
+    // 单帧记录（按键压缩为位掩码，共5字节）
+    struct Frame {
+        uint8_t keys;      // 按键位掩码（见packInput）
+        float deltaTime;   // 录制时的帧间隔（秒）
+    };
+
+    // 追加一帧
+    void push(const InputState& input, float deltaTime) {
+        frames.push_back({ packInput(input), deltaTime });
+    }
+    void clear() { frames.clear(); }
+
+    size_t size() const { return frames.size(); }
+    bool empty() const { return frames.empty(); }
+    const Frame& frame(size_t index) const { return frames[index]; }
+    InputState inputAt(size_t index) const { return unpackInput(frames[index].keys); }
+
+    // 读写二进制日志文件（失败时抛出异常）
+    void saveToFile(const std::string& filePath) const;
+    static InputLog loadFromFile(const std::string& filePath);
+
+    // InputState与位掩码互转
+    static uint8_t packInput(const InputState& input);
+    static InputState unpackInput(uint8_t keys);
+
+private:
+    std::vector<Frame> frames;
+};
+
+#endif // INPUT_LOG_H
@@ -0,0 +1,430 @@
+#include "KShortestPaths.h"
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <climits>
+#include <string>
+
+const int KShortestPaths::MAX_ROUTES;
+
+// 每个偏离搜索线程一份的A*状态（同PathQueryEngine::Scratch，用代号标记复用，不必每次清空）
+struct KShortestPaths::Worker {
+    struct HeapEntry {
+        int f;       // 成本 + 到终点的树上距离
+        int g;
+        int state;
+        bool operator>(const HeapEntry& other) const {
+            return f != other.f ? f > other.f : g < other.g;
+        }
+    };
+
+    Worker() : epoch(0), routeEpoch(0), searches(0), joins(0), expanded(0) {}
+
+    void prepare(size_t states) {
+        if (++epoch == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0u);
+            epoch = 1;
+        }
+        if (stamp.size() < states) {
+            stamp.resize(states, 0u);
+            dist.resize(states);
+            prev.resize(states);
+        }
+        heap.clear();
+    }
+    bool seen(int state) const { return stamp[state] == epoch; }
+    // 换一条路线：treeRouteIndex的缓存作废
+    void beginRoute(size_t states) {
+        if (++routeEpoch == 0) {
+            std::fill(routeStamp.begin(), routeStamp.end(), 0u);
+            routeEpoch = 1;
+        }
+        if (routeStamp.size() < states) {
+            routeStamp.resize(states, 0u);
+            routeIndex.resize(states);
+        }
+    }
+
+    std::vector<uint32_t> stamp;
+    std::vector<int> dist;
+    std::vector<int> prev;
+    std::vector<HeapEntry> heap;
+    uint32_t epoch;
+    std::vector<uint32_t> routeStamp;  // 等于routeEpoch时routeIndex有效
+    std::vector<int> routeIndex;
+    std::vector<int> walk;
+    uint32_t routeEpoch;
+    std::vector<Candidate> found;    // 本轮找到的候选
+    long long searches;
+    long long joins;
+    long long expanded;
+};
+
+namespace {
+    // 每个线程一次领取的偏离点数
+    const int SPUR_CHUNK = 8;
+}
+
+KShortestPaths::KShortestPaths(const PathQueryEngine& engine)
+    : engine(engine), grid(engine.getGrid()), treeAlgorithm(SearchAlgorithm::DIJKSTRA), treeLayers(0), treeGoal(-1),
+    pathIndex(engine.getGrid().getCellCount(), INT_MAX), loopCheck(engine.getGrid().getCellCount(), -1),
+    algorithm(SearchAlgorithm::DIJKSTRA), layers(1), goalCell(-1), hasDeadline(false), timedOut(false) {
+}
+
+KShortestPaths::~KShortestPaths() = default;
+
+int KShortestPaths::stepCost(BlockType block) const {
+    return algorithm == SearchAlgorithm::BFS ? 1 : PathFinder::tileCost(block);
+}
+
+bool KShortestPaths::expired() const {
+    if (timedOut.load(std::memory_order_relaxed)) return true;
+    if (hasDeadline && std::chrono::steady_clock::now() >= deadline) {
+        timedOut.store(true, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+// 反向松弛：出队状态(v, 已踩熔岩数uv)，邻格u走进v的成本是进入v的成本；熔岩预算查询中进入熔岩不计成本、
+// 已踩数加一，因此前驱状态是(u, uv - 1)。所有终点状态（任意已踩数）距离为0
+void KShortestPaths::buildTree(SearchAlgorithm treeModel, int treeLayerCount, int goal) {
+    if (treeGoal == goal && treeAlgorithm == treeModel && treeLayers == treeLayerCount) {
+        stats.treeReused = true;
+        return;
+    }
+    auto begin = std::chrono::steady_clock::now();
+    treeGoal = goal;
+    treeAlgorithm = treeModel;
+    treeLayers = treeLayerCount;
+    const bool lavaMode = treeModel == SearchAlgorithm::LAVA_ONCE;
+    const size_t states = grid.getCellCount() * treeLayerCount;
+    treeDist.assign(states, INT_MAX);
+    treeNext.assign(states, -1);
+
+    // 桶队列同LandmarkOracle：成本不超过MAX_TILE_COST，零成本的状态追加到正在处理的桶
+    const int BUCKETS = LandmarkOracle::MAX_TILE_COST + 1;
+    std::vector<std::vector<int>> buckets(BUCKETS);
+    size_t pending = 0;
+    for (int used = 0; used < treeLayerCount; ++used) {
+        const int state = goal * treeLayerCount + used;
+        treeDist[state] = 0;
+        buckets[0].push_back(state);
+        ++pending;
+    }
+    for (int current = 0; pending > 0; ++current) {
+        std::vector<int>& bucket = buckets[current % BUCKETS];
+        for (size_t i = 0; i < bucket.size(); ++i) {
+            const int state = bucket[i];
+            --pending;
+            if (treeDist[state] != current) continue;
+            const int cell = state / treeLayerCount;
+            const int used = state % treeLayerCount;
+            const BlockType block = grid.at(cell);
+            int fromUsed = used, cost;
+            if (lavaMode && block == BlockType::LAVA) {
+                if (used == 0) continue;
+                fromUsed = used - 1;
+                cost = 0;
+            }
+            else {
+                cost = stepCost(block);
+            }
+            const Point p = grid.position(cell);
+            for (int d = 0; d < 4; ++d) {
+                int from = grid.neighbor(cell, p.row, p.col, d);
+                if (from < 0 || grid.at(from) == BlockType::WALL) continue;
+                const int fromState = from * treeLayerCount + fromUsed;
+                const int newDist = current + cost;
+                if (newDist < treeDist[fromState]) {
+                    treeDist[fromState] = newDist;
+                    treeNext[fromState] = state;
+                    buckets[newDist % BUCKETS].push_back(fromState);
+                    ++pending;
+                }
+            }
+        }
+        bucket.clear();
+    }
+    stats.treeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+void KShortestPaths::markRoute(const Route& route) {
+    const bool lavaMode = algorithm == SearchAlgorithm::LAVA_ONCE;
+    const int length = static_cast<int>(route.cells.size());
+    rootCost.assign(length, 0);
+    rootUsed.assign(length, 0);
+    for (int i = 0; i < length; ++i) {
+        const int cell = route.cells[i];
+        pathIndex[cell] = i;
+        if (i == 0) continue;
+        const BlockType block = grid.at(cell);
+        const bool freeLava = lavaMode && block == BlockType::LAVA;
+        rootCost[i] = rootCost[i - 1] + (freeLava ? 0 : stepCost(block));
+        rootUsed[i] = rootUsed[i - 1] + (freeLava ? 1 : 0);
+    }
+}
+
+void KShortestPaths::unmarkRoute(const Route& route) {
+    for (int cell : route.cells) pathIndex[cell] = INT_MAX;
+}
+
+// 沿树向终点走到第一个已缓存的状态，再倒着填回途经的状态；同一条路线内每个状态只走一次
+int KShortestPaths::treeRouteIndex(Worker& worker, int state) const {
+    std::vector<int>& walk = worker.walk;
+    walk.clear();
+    int result = INT_MAX;
+    for (int cur = state; cur >= 0; cur = treeNext[cur]) {
+        if (worker.routeStamp[cur] == worker.routeEpoch) {
+            result = worker.routeIndex[cur];
+            break;
+        }
+        walk.push_back(cur);
+    }
+    for (size_t i = walk.size(); i-- > 0;) {
+        result = std::min(result, pathIndex[walk[i] / layers]);
+        worker.routeStamp[walk[i]] = worker.routeEpoch;
+        worker.routeIndex[walk[i]] = result;
+    }
+    return result;
+}
+
+// A*：下界为到终点的树上距离，只展开不在根路径上（pathIndex大于index）的格子，偏离点的第一步避开banned。
+// 出堆状态沿树走到终点经过的路线下标都大于index时，它沿树到终点的路径在删点删边后的图中仍然存在、成本等于下界，
+// 而f是堆中最小的，因此接上树路径即为最优
+bool KShortestPaths::spur(Worker& worker, const std::vector<Route>& accepted, int baseIndex, int index,
+    const std::vector<int>& sharedPrefix, Candidate& candidate) const {
+    const Route& base = accepted[baseIndex];
+    // 根路径与base相同的已选路线在偏离点的下一格（含base自己）
+    int banned[MAX_ROUTES];
+    int bannedCount = 0;
+    for (size_t j = 0; j < accepted.size(); ++j) {
+        if (sharedPrefix[j] > index) banned[bannedCount++] = accepted[j].cells[index + 1];
+    }
+
+    ++worker.searches;
+    worker.prepare(grid.getCellCount() * layers);
+    const bool lavaMode = algorithm == SearchAlgorithm::LAVA_ONCE;
+    const int budget = layers - 1;
+    std::vector<Worker::HeapEntry>& heap = worker.heap;
+    const int startState = base.cells[index] * layers + rootUsed[index];
+    worker.stamp[startState] = worker.epoch;
+    worker.dist[startState] = 0;
+    worker.prev[startState] = -1;
+    heap.push_back({ treeDist[startState], 0, startState });
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<Worker::HeapEntry>());
+        const Worker::HeapEntry top = heap.back();
+        heap.pop_back();
+        if (top.g > worker.dist[top.state]) continue; // 过期条目
+
+        const int state = top.state;
+        if ((++worker.expanded & 4095) == 0 && expired()) return false;
+        if (state != startState && treeRouteIndex(worker, state) > index) {
+            candidate.cost = rootCost[index] + top.f;
+            candidate.parent = baseIndex;
+            candidate.deviation = index;
+            candidate.tail.clear();
+            for (int cur = state; cur != startState; cur = worker.prev[cur]) candidate.tail.push_back(cur);
+            std::reverse(candidate.tail.begin(), candidate.tail.end());
+            if (worker.prev[state] == startState) ++worker.joins;
+            return true;
+        }
+
+        const int cell = state / layers;
+        const int used = state % layers;
+        const Point p = grid.position(cell);
+        for (int d = 0; d < 4; ++d) {
+            int next = grid.neighbor(cell, p.row, p.col, d);
+            if (next < 0 || pathIndex[next] <= index) continue;
+            BlockType block = grid.at(next);
+            if (block == BlockType::WALL) continue;
+            if (state == startState && std::find(banned, banned + bannedCount, next) != banned + bannedCount) continue;
+            int nextUsed = used, cost;
+            if (lavaMode && block == BlockType::LAVA) {
+                if (used == budget) continue;
+                ++nextUsed;
+                cost = 0;
+            }
+            else {
+                cost = stepCost(block);
+            }
+            const int nextState = next * layers + nextUsed;
+            const int h = treeDist[nextState];
+            if (h == INT_MAX) continue;
+            const int g = top.g + cost;
+            if (worker.seen(nextState) && g >= worker.dist[nextState]) continue;
+            worker.stamp[nextState] = worker.epoch;
+            worker.dist[nextState] = g;
+            worker.prev[nextState] = state;
+            heap.push_back({ g + h, g, nextState });
+            std::push_heap(heap.begin(), heap.end(), std::greater<Worker::HeapEntry>());
+        }
+    }
+    return false;
+}
+
+// 拼接根路径、偏离段和树路径。(格子, 已踩熔岩数)的状态路径可能在不同层经过同一格（只能是全熔岩的零成本环），
+// 再次经过时退回到上次经过的位置，成本不变
+void KShortestPaths::materialize(const std::vector<int>& prefix, int prefixLength, const std::vector<int>& tail, Route& route) {
+    route.cells.clear();
+    auto append = [&](int cell) {
+        if (loopCheck[cell] >= 0) {
+            const size_t keep = static_cast<size_t>(loopCheck[cell]) + 1;
+            for (size_t j = keep; j < route.cells.size(); ++j) loopCheck[route.cells[j]] = -1;
+            route.cells.resize(keep);
+            return;
+        }
+        loopCheck[cell] = static_cast<int>(route.cells.size());
+        route.cells.push_back(cell);
+    };
+    for (int i = 0; i < prefixLength; ++i) append(prefix[i]);
+    for (int state : tail) append(state / layers);
+    for (int state = treeNext[tail.back()]; state >= 0; state = treeNext[state]) append(state / layers);
+
+    const bool lavaMode = algorithm == SearchAlgorithm::LAVA_ONCE;
+    route.cost = 0;
+    route.lavaSteps = 0;
+    for (size_t i = 0; i < route.cells.size(); ++i) {
+        loopCheck[route.cells[i]] = -1;
+        if (i == 0) continue;
+        const BlockType block = grid.at(route.cells[i]);
+        if (block == BlockType::LAVA) ++route.lavaSteps;
+        route.cost += lavaMode && block == BlockType::LAVA ? 0 : stepCost(block);
+    }
+}
+
+void KShortestPaths::find(const Point& start, const Point& goal, const RouteOptions& options, std::vector<RankedRoute>& routes) {
+    auto begin = std::chrono::steady_clock::now();
+    engine.checkQuery(options.algorithm, start, goal, options.lavaBudget);
+    if (options.count < 1 || options.count > MAX_ROUTES) {
+        throw std::runtime_error("Route count must be between 1 and " + std::to_string(MAX_ROUTES));
+    }
+    stats = Stats();
+    routes.clear();
+    hasDeadline = options.timeBudgetMs > 0.0;
+    deadline = begin + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::milli>(options.timeBudgetMs));
+    timedOut.store(false);
+    auto finish = [&]() {
+        stats.totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    };
+    if (!engine.isConnected(start, goal)) {
+        finish();
+        return;
+    }
+
+    algorithm = options.algorithm;
+    layers = algorithm == SearchAlgorithm::LAVA_ONCE ? options.lavaBudget + 1 : 1;
+    goalCell = grid.index(goal.row, goal.col);
+    buildTree(algorithm, layers, goalCell);
+    const int startState = grid.index(start.row, start.col) * layers;
+    if (treeDist[startState] == INT_MAX) {
+        finish();
+        return;
+    }
+
+    std::vector<Route> accepted;
+    accepted.reserve(options.count);
+    accepted.emplace_back();
+    materialize(std::vector<int>(), 0, std::vector<int>(1, startState), accepted.back());
+    accepted.back().deviation = 0;
+
+    const int threadCount = std::max(1, options.threads);
+    std::vector<Candidate> candidates;
+    std::vector<int> sharedPrefix;
+    while (static_cast<int>(accepted.size()) < options.count) {
+        const int baseIndex = static_cast<int>(accepted.size()) - 1;
+        const Route& base = accepted[baseIndex];
+        const size_t need = options.count - accepted.size();
+        markRoute(base);
+        sharedPrefix.assign(accepted.size(), 0);
+        for (size_t j = 0; j < accepted.size(); ++j) {
+            const std::vector<int>& cells = accepted[j].cells;
+            const size_t limit = std::min(cells.size(), base.cells.size());
+            size_t same = 0;
+            while (same < limit && cells[same] == base.cells[same]) ++same;
+            sharedPrefix[j] = static_cast<int>(same);
+        }
+
+        // 偏离点[deviation, 长度-2]分块领取；每个线程的候选超过需要的两倍时截断
+        const int first = base.deviation, last = static_cast<int>(base.cells.size()) - 2;
+        const int active = std::max(1, std::min(threadCount, (last - first + SPUR_CHUNK) / SPUR_CHUNK));
+        while (static_cast<int>(workers.size()) < active) workers.emplace_back(new Worker());
+        std::atomic<int> nextIndex(first);
+        auto work = [&](Worker& worker) {
+            worker.found.clear();
+            worker.beginRoute(grid.getCellCount() * layers);
+            Candidate candidate;
+            while (true) {
+                const int chunk = nextIndex.fetch_add(SPUR_CHUNK);
+                if (chunk > last) break;
+                for (int i = chunk; i <= std::min(last, chunk + SPUR_CHUNK - 1); ++i) {
+                    if (expired()) return;
+                    if (!spur(worker, accepted, baseIndex, i, sharedPrefix, candidate)) continue;
+                    worker.found.push_back(std::move(candidate));
+                    if (worker.found.size() >= 2 * need) {
+                        std::nth_element(worker.found.begin(), worker.found.begin() + need, worker.found.end());
+                        worker.found.resize(need);
+                    }
+                }
+            }
+        };
+        std::vector<std::thread> threads;
+        for (int t = 1; t < active; ++t) threads.emplace_back(work, std::ref(*workers[t]));
+        work(*workers[0]);
+        for (std::thread& thread : threads) thread.join();
+        unmarkRoute(base);
+
+        for (int t = 0; t < active; ++t) {
+            Worker& worker = *workers[t];
+            for (Candidate& candidate : worker.found) candidates.push_back(std::move(candidate));
+            worker.found.clear();
+        }
+        stats.peakCandidates = std::max(stats.peakCandidates, candidates.size());
+        if (timedOut.load()) {
+            // 本轮候选不全，最小的一条不一定是下一条最短路线
+            stats.truncated = true;
+            break;
+        }
+        std::sort(candidates.begin(), candidates.end());
+        if (candidates.size() > need) candidates.resize(need);
+
+        // 取最便宜的候选；与已选路线重复（剪环后可能发生）时跳过
+        bool added = false;
+        while (!candidates.empty() && !added) {
+            Candidate best = std::move(candidates.front());
+            candidates.erase(candidates.begin());
+            Route route;
+            materialize(accepted[best.parent].cells, best.deviation + 1, best.tail, route);
+            route.deviation = best.deviation;
+            bool duplicate = false;
+            for (const Route& other : accepted) {
+                if (other.cost == route.cost && other.cells == route.cells) duplicate = true;
+            }
+            if (!duplicate) {
+                accepted.push_back(std::move(route));
+                added = true;
+            }
+        }
+        if (!added) break;
+    }
+
+    for (int t = 0; t < static_cast<int>(workers.size()); ++t) {
+        stats.spurSearches += workers[t]->searches;
+        stats.treeJoins += workers[t]->joins;
+        stats.expanded += workers[t]->expanded;
+        workers[t]->searches = workers[t]->joins = workers[t]->expanded = 0;
+    }
+    routes.resize(accepted.size());
+    for (size_t i = 0; i < accepted.size(); ++i) {
+        RankedRoute& out = routes[i];
+        out.cost = accepted[i].cost;
+        out.lavaSteps = accepted[i].lavaSteps;
+        out.deviation = accepted[i].deviation;
+        out.path.clear();
+        for (int cell : accepted[i].cells) out.path.push_back(grid.position(cell));
+    }
+    finish();
+}
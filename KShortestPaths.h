@@ -0,0 +1,124 @@
+#ifndef K_SHORTEST_PATHS_H
+#define K_SHORTEST_PATHS_H
+#include "PathQueryEngine.h"
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// 一条备选路线
+struct RankedRoute {
+    int cost = 0;                  // 按算法计的路径成本（BFS为步数）
+    int lavaSteps = 0;             // 路径踩到的熔岩格数
+    int deviation = 0;             // 与派生它的上一条路线开始分叉的路径下标（第一条为0）
+    std::vector<Point> path;       // 起点到终点（含两端）
+};
+
+// 备选路线查询的参数
+struct RouteOptions {
+    int count = 5;                                          // 要求的路线条数（k）
+    SearchAlgorithm algorithm = SearchAlgorithm::DIJKSTRA;
+    int lavaBudget = 1;                                     // 仅LAVA_ONCE使用
+    int threads = 1;                                        // 偏离搜索的并行线程数
+    double timeBudgetMs = 0.0;                              // 超时后只返回已确定的路线；0表示不限
+};
+
+// 前k条最短无环路线（Yen算法加Lawler改进），供关卡设计查看路线多样性，代替findAllPathsByDFS的穷举：
+// 第i条路线由之前的某条路线在偏离点分叉得到——偏离点之前沿原路线走（根路径），之后在去掉根路径上的格子、
+// 禁止走已选路线在同一根路径下的下一格的图上求最短路（偏离搜索）；新路线只需从自己的偏离点往后做偏离搜索。
+// - 先以终点为根建一棵反向最短路树（同一终点、算法、熔岩预算的后续查询直接复用）。删点删边只会让距离变长，
+//   树上距离是偏离搜索精确且一致的A*下界；出堆的状态沿树走到终点不碰根路径时立即接上树路径结束
+//   （“沿树会碰到路线上哪个下标”按线程缓存，每条路线的开销与搜索触及的状态数成正比，不扫全图）；
+// - 同一条路线的各偏离点互不依赖，分给多个线程并行，每个线程一份搜索状态；
+// - 候选只保留仍需要的条数（更差的候选不可能入选），且只记录到接上最短路树为止，内存与k和路径长度成正比；
+// 成本模型与PathQueryEngine一致；熔岩预算查询的状态为(格子, 已踩熔岩数)，路径中经过全熔岩零成本环重复的格子会被剪掉
+class KShortestPaths {
+public:
+    static const int MAX_ROUTES = 64;
+
+    // engine须在本对象的生命期内保持有效
+    explicit KShortestPaths(const PathQueryEngine& engine);
+    ~KShortestPaths();
+
+    KShortestPaths(const KShortestPaths&) = delete;
+    KShortestPaths& operator=(const KShortestPaths&) = delete;
+
+    // 按成本升序写入至多options.count条互不相同的无环路线（复用routes的容量）。
+    // 端点、熔岩预算检查同PathQueryEngine::solve，count超出[1, MAX_ROUTES]时抛出runtime_error；
+    // 无路径时routes为空；超时时routes为已确定的前若干条，getLastStats().truncated为true
+    void find(const Point& start, const Point& goal, const RouteOptions& options, std::vector<RankedRoute>& routes);
+
+    // 上一次find的统计
+    struct Stats {
+        long long spurSearches = 0;     // 偏离搜索次数
+        long long treeJoins = 0;        // 在偏离点的邻格就接上最短路树的偏离搜索数
+        long long expanded = 0;         // 偏离搜索扩展的状态总数
+        size_t peakCandidates = 0;      // 候选集合的最大条数
+        bool treeReused = false;        // 终点最短路树来自上一次查询
+        bool truncated = false;         // 因超时未求满
+        double treeMs = 0.0;            // 建终点最短路树耗时（毫秒）
+        double totalMs = 0.0;
+    };
+    const Stats& getLastStats() const { return stats; }
+
+private:
+    // 已选路线（格子按网格序号）
+    struct Route {
+        int cost;
+        int lavaSteps;
+        int deviation;
+        std::vector<int> cells;
+    };
+    // 候选：parent路线在deviation处分叉，tail为偏离点之后直到接上最短路树的状态，之后沿树走到终点
+    struct Candidate {
+        int cost;
+        int parent;
+        int deviation;
+        std::vector<int> tail;
+        bool operator<(const Candidate& other) const {
+            if (cost != other.cost) return cost < other.cost;
+            return parent != other.parent ? parent < other.parent : deviation < other.deviation;
+        }
+    };
+    struct Worker;
+
+    // 以goalCell为根、按状态(格子, 已踩熔岩数)的反向最短路树（Dial桶队列）；键相同时不重建
+    void buildTree(SearchAlgorithm algorithm, int layers, int goalCell);
+    // 标记当前路线：pathIndex为格子在路线中的下标，rootCost/rootUsed为走到各下标的成本与已踩熔岩数
+    void markRoute(const Route& route);
+    void unmarkRoute(const Route& route);
+    // accepted[baseIndex]在index处的偏离搜索；sharedPrefix[j]为accepted[j]与该路线开头相同的格数。找到时写入candidate并返回true
+    bool spur(Worker& worker, const std::vector<Route>& accepted, int baseIndex, int index,
+        const std::vector<int>& sharedPrefix, Candidate& candidate) const;
+    // 从state沿树走到终点经过的格子在当前路线中的最小下标（不经过时为INT_MAX），结果按worker缓存
+    int treeRouteIndex(Worker& worker, int state) const;
+    // 候选（或从起点状态沿树）展开为路线：拼接、剪掉零成本环、重算成本
+    void materialize(const std::vector<int>& prefix, int prefixLength, const std::vector<int>& tail, Route& route);
+    int stepCost(BlockType block) const;
+    bool expired() const;
+
+    const PathQueryEngine& engine;
+    const CellGrid& grid;
+    // 终点最短路树
+    SearchAlgorithm treeAlgorithm;
+    int treeLayers;
+    int treeGoal;                   // -1表示未建
+    std::vector<int> treeDist;      // 状态到终点的成本
+    std::vector<int> treeNext;      // 朝终点的下一状态（终点状态为-1）
+    std::vector<int> pathIndex;     // 按格子；不在当前路线上为INT_MAX
+    std::vector<int> rootCost;      // 当前路线走到各下标的成本
+    std::vector<int> rootUsed;      // 当前路线走到各下标已踩的熔岩数
+    std::vector<int> loopCheck;     // materialize剪环用，按格子；-1表示不在路径中
+    std::vector<std::unique_ptr<Worker>> workers;
+    // 本次查询
+    SearchAlgorithm algorithm;
+    int layers;
+    int goalCell;
+    std::chrono::steady_clock::time_point deadline;
+    bool hasDeadline;
+    mutable std::atomic<bool> timedOut;
+    Stats stats;
+};
+
+#endif // K_SHORTEST_PATHS_H
@@ -0,0 +1,128 @@
+#include "LandmarkOracle.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+
+const int LandmarkOracle::MAX_LANDMARKS;
+const uint16_t LandmarkOracle::UNREACHABLE;
+const int LandmarkOracle::MAX_TILE_COST;
+
+int LandmarkOracle::cellCost(int cell) const {
+    BlockType block = grid->at(cell);
+    switch (costModel) {
+    case SearchAlgorithm::BFS:       return 1;
+    case SearchAlgorithm::DIJKSTRA:  return PathFinder::tileCost(block);
+    default:                         return block == BlockType::LAVA ? 0 : PathFinder::tileCost(block);
+    }
+}
+
+// 单源最短路用桶队列（Dial）：格子成本是不超过MAX_TILE_COST的小整数，按距离取模放进环形桶，
+// 出队不需要比较，比二叉堆快数倍（每个地标都要跑一遍全图，预处理时间主要花在这里）
+void LandmarkOracle::singleSource(int root, std::vector<int>& dist) const {
+    const int BUCKETS = MAX_TILE_COST + 1;
+    std::fill(dist.begin(), dist.end(), INT_MAX);
+    std::vector<std::vector<int>> buckets(BUCKETS);
+    dist[root] = 0;
+    buckets[0].push_back(root);
+    size_t pending = 1;
+    for (int current = 0; pending > 0; ++current) {
+        std::vector<int>& bucket = buckets[current % BUCKETS];
+        // 成本为0的格子（松弛模型中的熔岩）会追加到正在处理的桶，按下标遍历以包含它们
+        for (size_t i = 0; i < bucket.size(); ++i) {
+            const int cell = bucket[i];
+            --pending;
+            if (dist[cell] != current) continue; // 已被更短距离取代
+            const Point p = grid->position(cell);
+            for (int d = 0; d < 4; ++d) {
+                int next = grid->neighbor(cell, p.row, p.col, d);
+                if (next < 0 || grid->at(next) == BlockType::WALL) continue;
+                int newDist = current + cellCost(next);
+                if (newDist < dist[next]) {
+                    dist[next] = newDist;
+                    buckets[newDist % BUCKETS].push_back(next);
+                    ++pending;
+                }
+            }
+        }
+        bucket.clear();
+    }
+}
+
+// 最远点选地标：第一个取离seed最远的格子，之后每个取“到已选地标的最近距离”最大的格子；
+// 每个地标的单源最短路同时就是它的距离表，选点不需要额外搜索。
+// 量化比例在第一遍（seed出发）就定下：d(L, v) <= d(L, seed) + d(seed, v) = d(seed, L) - c(L) + c(seed) + d(seed, v)
+// <= 2 * ecc(seed) + c(seed)（ecc为seed到分量内最远格的成本），之后每个地标的一遍直接量化写入table，
+// 峰值内存只有table加两张int数组，不随地标数增长
+void LandmarkOracle::build(const CellGrid& cellGrid, SearchAlgorithm model, const Point& seed, int count) {
+    auto begin = std::chrono::steady_clock::now();
+    grid = &cellGrid;
+    costModel = model;
+    count = std::max(1, std::min(count, MAX_LANDMARKS));
+    const size_t cells = grid->getCellCount();
+    landmarks.clear();
+
+    std::vector<int> dist(cells);
+    const int seedCell = grid->index(seed.row, seed.col);
+    singleSource(seedCell, dist);
+    std::vector<int> nearest(dist);  // 到已选地标（首轮为seed）的最近距离
+    long long eccentricity = 0;
+    for (size_t cell = 0; cell < cells; ++cell) {
+        if (dist[cell] != INT_MAX) eccentricity = std::max<long long>(eccentricity, dist[cell]);
+    }
+    scale = static_cast<int>((2 * eccentricity + cellCost(seedCell)) / UNREACHABLE + 1); // 量化后最大值不超过UNREACHABLE - 1
+
+    // 先按count个地标的步长填表，分量太小、提前停止时再压紧
+    table.assign(cells * count, UNREACHABLE);
+    while (static_cast<int>(landmarks.size()) < count) {
+        int farthest = -1;
+        for (size_t cell = 0; cell < cells; ++cell) {
+            if (nearest[cell] != INT_MAX && (farthest < 0 || nearest[cell] > nearest[farthest])) farthest = static_cast<int>(cell);
+        }
+        // 分量比地标数还小时，后面的最远距离为0，不再重复选同一格
+        if (!landmarks.empty() && nearest[farthest] == 0) break;
+        const size_t k = landmarks.size();
+        landmarks.push_back(farthest);
+        singleSource(farthest, dist);
+        for (size_t cell = 0; cell < cells; ++cell) {
+            if (dist[cell] == INT_MAX) continue;
+            if (k == 0 || dist[cell] < nearest[cell]) nearest[cell] = dist[cell];
+            table[cell * count + k] = static_cast<uint16_t>(dist[cell] / scale);
+        }
+    }
+
+    landmarkCount = static_cast<int>(landmarks.size());
+    if (landmarkCount < count) {
+        // 步长变小，按格子顺序前移不会覆盖尚未搬动的数据
+        for (size_t cell = 0; cell < cells; ++cell) {
+            for (int k = 0; k < landmarkCount; ++k) table[cell * landmarkCount + k] = table[cell * count + k];
+        }
+        table.resize(cells * landmarkCount);
+        table.shrink_to_fit();
+    }
+    buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+void LandmarkOracle::prepareTarget(int cell, Target& target) const {
+    target.cost = cellCost(cell);
+    target.covered = isBuilt() && table[static_cast<size_t>(cell) * landmarkCount] != UNREACHABLE;
+    for (int k = 0; k < landmarkCount; ++k) target.dist[k] = table[static_cast<size_t>(cell) * landmarkCount + k];
+}
+
+// 上界：d(s, t) <= d(s, L) + d(L, t) = d(L, s) - c(s) + c(L) + d(L, t)，量化时两项各按上取整放宽
+DistanceBounds LandmarkOracle::bounds(int fromCell, int toCell) const {
+    DistanceBounds result;
+    Target target;
+    prepareTarget(toCell, target);
+    if (!target.covered || table[static_cast<size_t>(fromCell) * landmarkCount] == UNREACHABLE) return result;
+    result.known = true;
+    result.lower = fromCell == toCell ? 0 : lowerBound(fromCell, target);
+    result.upper = INT_MAX;
+    const uint16_t* row = &table[static_cast<size_t>(fromCell) * landmarkCount];
+    const int fromCost = cellCost(fromCell);
+    for (int k = 0; k < landmarkCount; ++k) {
+        int viaLandmark = (row[k] + target.dist[k]) * scale + 2 * (scale - 1) - fromCost + cellCost(landmarks[k]);
+        result.upper = std::min(result.upper, viaLandmark);
+    }
+    if (fromCell == toCell) result.upper = 0;
+    return result;
+}
@@ -0,0 +1,81 @@
+#ifndef LANDMARK_ORACLE_H
+#define LANDMARK_ORACLE_H
+#include "CellGrid.h"
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+// 不经搜索给出的点对距离区间
+struct DistanceBounds {
+    bool known = false;  // 两端都被地标覆盖（同一连通分量）时为true，lower/upper才有效
+    int lower = 0;
+    int upper = 0;
+};
+
+// 地标距离预言机（ALT，无头核心）：选K个地标（最远点法：下一个地标取离已选地标最远的格子），
+// 预先算好每个地标到所有格子的成本，按三角不等式给出任意两格之间距离的上下界，
+// 作为A*的下界比曼哈顿距离紧得多。
+// - 成本是“进入格子的成本”，不对称：d(v, L) = d(L, v) - c(v) + c(L)，只需存地标出发的一张表；
+// - 表按格子主序存放（一格的K个距离相邻），一次查询只读一条缓存行；
+// - 距离压缩为16位：距离上界（由seed出发的一遍估出）超出时整体按scale量化（存floor(d / scale)），界相应放宽至多scale - 1
+class LandmarkOracle {
+public:
+    static const int MAX_LANDMARKS = 16;
+    static const uint16_t UNREACHABLE = 0xFFFF;
+    static const int MAX_TILE_COST = 1000;  // 最贵的地块（熔岩）成本，桶队列的桶数由此决定
+
+    LandmarkOracle() : grid(nullptr), costModel(SearchAlgorithm::DIJKSTRA), landmarkCount(0), scale(1), buildMs(0.0) {}
+
+    // 在seed所在连通分量内选count个地标并建表（count超出[1, MAX_LANDMARKS]时截断）。
+    // costModel决定格子成本：BFS每格1，DIJKSTRA为PathFinder::tileCost，LAVA_ONCE为熔岩不计成本的松弛
+    // （不限熔岩数，因此对任意熔岩预算都是下界）。grid须在本对象的生命期内保持有效
+    void build(const CellGrid& grid, SearchAlgorithm costModel, const Point& seed, int count);
+    bool isBuilt() const { return landmarkCount > 0; }
+
+    // 一次A*查询的终点：开始搜索前取一次终点的地标距离
+    struct Target {
+        int cost = 0;                        // 终点格的成本
+        bool covered = false;                // 终点被地标覆盖
+        uint16_t dist[MAX_LANDMARKS] = {};
+    };
+    void prepareTarget(int cell, Target& target) const;
+
+    // cell到终点成本的下界（可采纳；量化时不一定一致，A*须允许重新打开节点）
+    int lowerBound(int cell, const Target& target) const {
+        if (!target.covered) return 0;
+        const uint16_t* row = &table[static_cast<size_t>(cell) * landmarkCount];
+        if (row[0] == UNREACHABLE) return 0;
+        const int costDelta = target.cost - cellCost(cell);
+        int best = 0;
+        for (int k = 0; k < landmarkCount; ++k) {
+            const int forward = static_cast<int>(target.dist[k]) - row[k];    // d(L,t) - d(L,v)
+            const int backward = -forward * scale + costDelta;                 // d(v,L) - d(t,L)
+            best = std::max(best, std::max(forward * scale, backward));
+        }
+        return std::max(0, best - (scale - 1));
+    }
+
+    // 不经搜索的距离区间：下界取各地标三角不等式的最大值，上界取经过各地标绕行的最小值
+    DistanceBounds bounds(int fromCell, int toCell) const;
+
+    int getLandmarkCount() const { return landmarkCount; }
+    Point getLandmark(int i) const { return grid->position(landmarks[i]); }
+    int getScale() const { return scale; }
+    double getBuildMs() const { return buildMs; }
+    size_t getTableBytes() const { return table.size() * sizeof(uint16_t); }
+
+private:
+    int cellCost(int cell) const;
+    // 单源最短路（进入格子计成本），dist预先按格数分配
+    void singleSource(int root, std::vector<int>& dist) const;
+
+    const CellGrid* grid;
+    SearchAlgorithm costModel;
+    int landmarkCount;
+    int scale;
+    std::vector<int> landmarks;          // 地标的网格序号
+    std::vector<uint16_t> table;         // [格子 * landmarkCount + k] = floor(d(L_k, 格子) / scale)
+    double buildMs;
+};
+
+#endif // LANDMARK_ORACLE_H
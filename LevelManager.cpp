@@ -0,0 +1,294 @@
+#include "LevelManager.h"
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    const int DIRS[4][2] = { {-1,0}, {1,0}, {0,-1}, {0,1} };
+
+    double msSince(std::chrono::steady_clock::time_point begin) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+}
+
+// 构造：解析 → 对局（校验起终点、构建碰撞结构）→ 连通分量 → 终点距离场
+Level::Level(const std::string& filePath, int playerFrameWidth, int playerFrameHeight, int playerFrameCols)
+    : filePath(filePath),
+    maze(MazeParser::loadFromFile(filePath)),
+    session(maze, playerFrameWidth, playerFrameHeight, playerFrameCols),
+    componentCount(0),
+    buildMs(0.0) {
+    auto begin = std::chrono::steady_clock::now();
+    labelComponents();
+    exitField.build(session.getCollisionMap(), session.getEndPoint());
+    buildMs = msSince(begin);
+}
+
+void Level::labelComponents() {
+    componentLabels.assign(static_cast<size_t>(maze.rows) * maze.cols, -1);
+    componentSizes.clear();
+    std::vector<int> stack;
+    for (int row = 0; row < maze.rows; ++row) {
+        for (int col = 0; col < maze.cols; ++col) {
+            int seed = row * maze.cols + col;
+            if (componentLabels[seed] != -1 || maze.mapData[row][col] == BlockType::WALL) continue;
+            componentLabels[seed] = componentCount;
+            componentSizes.push_back(0);
+            stack.push_back(seed);
+            while (!stack.empty()) {
+                int cell = stack.back();
+                stack.pop_back();
+                ++componentSizes[componentCount];
+                int r = cell / maze.cols, c = cell % maze.cols;
+                for (const auto& dir : DIRS) {
+                    int nr = r + dir[0], nc = c + dir[1];
+                    if (nr < 0 || nr >= maze.rows || nc < 0 || nc >= maze.cols) continue;
+                    int next = nr * maze.cols + nc;
+                    if (componentLabels[next] != -1 || maze.mapData[nr][nc] == BlockType::WALL) continue;
+                    componentLabels[next] = componentCount;
+                    stack.push_back(next);
+                }
+            }
+            ++componentCount;
+        }
+    }
+}
+
+bool Level::applyEdit(const Maze& edited, std::vector<CellChange>& changes) {
+    changes.clear();
+    if (edited.rows != maze.rows || edited.cols != maze.cols) return false;
+    for (int row = 0; row < maze.rows; ++row) {
+        for (int col = 0; col < maze.cols; ++col) {
+            BlockType before = maze.mapData[row][col], after = edited.mapData[row][col];
+            if (before == after) continue;
+            // 起终点移动会改变对局、寻路的锚点，只能整关重建
+            if (before == BlockType::START || before == BlockType::END
+                || after == BlockType::START || after == BlockType::END) {
+                changes.clear();
+                return false;
+            }
+            changes.push_back({ { row, col }, before, after });
+        }
+    }
+
+    std::vector<Point> wallCells;
+    for (const CellChange& change : changes) {
+        maze.mapData[change.cell.row][change.cell.col] = change.after;
+        if ((change.before == BlockType::WALL) != (change.after == BlockType::WALL)) {
+            wallCells.push_back(change.cell);
+        }
+    }
+    if (!wallCells.empty()) {
+        session.refreshWalls(wallCells);
+        for (const Point& p : wallCells) {
+            int cell = p.row * maze.cols + p.col;
+            if (maze.mapData[p.row][p.col] == BlockType::WALL) closeCell(cell);
+            else openCell(cell);
+        }
+        exitField.updateWalls(session.getCollisionMap(), wallCells);
+    }
+    return true;
+}
+
+int Level::relabel(int cell, int from, int to) {
+    int count = 0;
+    std::vector<int> stack(1, cell);
+    componentLabels[cell] = to;
+    while (!stack.empty()) {
+        int cur = stack.back();
+        stack.pop_back();
+        ++count;
+        int r = cur / maze.cols, c = cur % maze.cols;
+        for (const auto& dir : DIRS) {
+            int nr = r + dir[0], nc = c + dir[1];
+            if (nr < 0 || nr >= maze.rows || nc < 0 || nc >= maze.cols) continue;
+            int next = nr * maze.cols + nc;
+            if (componentLabels[next] != from) continue;
+            componentLabels[next] = to;
+            stack.push_back(next);
+        }
+    }
+    return count;
+}
+
+// 合并：保留格数最多的分量编号，其余相邻分量整体改号（开销与被改号的分量大小成正比）
+void Level::openCell(int cell) {
+    const int r = cell / maze.cols, c = cell % maze.cols;
+    int survivor = -1;
+    for (const auto& dir : DIRS) {
+        int nr = r + dir[0], nc = c + dir[1];
+        if (nr < 0 || nr >= maze.rows || nc < 0 || nc >= maze.cols) continue;
+        int label = componentLabels[nr * maze.cols + nc];
+        if (label >= 0 && (survivor < 0 || componentSizes[label] > componentSizes[survivor])) survivor = label;
+    }
+    if (survivor < 0) {
+        // 四周都是墙：自成一个新分量
+        componentLabels[cell] = static_cast<int>(componentSizes.size());
+        componentSizes.push_back(1);
+        ++componentCount;
+        return;
+    }
+    componentLabels[cell] = survivor;
+    ++componentSizes[survivor];
+    for (const auto& dir : DIRS) {
+        int nr = r + dir[0], nc = c + dir[1];
+        if (nr < 0 || nr >= maze.rows || nc < 0 || nc >= maze.cols) continue;
+        int next = nr * maze.cols + nc;
+        int label = componentLabels[next];
+        if (label < 0 || label == survivor) continue;
+        componentSizes[survivor] += relabel(next, label, survivor);
+        componentSizes[label] = 0;
+        --componentCount;
+    }
+}
+
+// 切分检测：从被堵格的各个相邻格同时做BFS（每轮各走一步），两个搜索相遇即归为一组；
+// 某组的搜索全部走完说明它是独立的一块，改用新编号。只剩一组时停止，剩下的部分沿用原编号，
+// 因此开销与较小的几块（或各邻格重新相遇所需的范围）成正比，而不是整个分量
+void Level::closeCell(int cell) {
+    const int label = componentLabels[cell];
+    componentLabels[cell] = -1;
+    --componentSizes[label];
+
+    const int r = cell / maze.cols, c = cell % maze.cols;
+    std::vector<int> queues[4];
+    size_t heads[4] = { 0, 0, 0, 0 };
+    int group[4] = { 0, 1, 2, 3 };
+    bool finished[4] = { false, false, false, false };
+    int searches = 0;
+    if (searchOwner.empty()) searchOwner.assign(componentLabels.size(), -1);
+    for (const auto& dir : DIRS) {
+        int nr = r + dir[0], nc = c + dir[1];
+        if (nr < 0 || nr >= maze.rows || nc < 0 || nc >= maze.cols) continue;
+        int next = nr * maze.cols + nc;
+        if (componentLabels[next] != label) continue;
+        searchOwner[next] = searches;
+        queues[searches].push_back(next);
+        ++searches;
+    }
+    if (searches == 0) {
+        --componentCount;   // 孤立的一格被堵上，分量消失
+        return;
+    }
+
+    auto find = [&group](int i) {
+        while (group[i] != i) i = group[i];
+        return i;
+    };
+    int groups = searches;
+    while (groups > 1) {
+        // 各搜索前进一步
+        for (int i = 0; i < searches && groups > 1; ++i) {
+            if (finished[find(i)] || heads[i] == queues[i].size()) continue;
+            int cur = queues[i][heads[i]++];
+            int cr = cur / maze.cols, cc = cur % maze.cols;
+            for (const auto& dir : DIRS) {
+                int nr = cr + dir[0], nc = cc + dir[1];
+                if (nr < 0 || nr >= maze.rows || nc < 0 || nc >= maze.cols) continue;
+                int next = nr * maze.cols + nc;
+                if (componentLabels[next] != label) continue;
+                if (searchOwner[next] < 0) {
+                    searchOwner[next] = i;
+                    queues[i].push_back(next);
+                }
+                else {
+                    int a = find(i), b = find(searchOwner[next]);
+                    if (a != b) {
+                        group[b] = a;
+                        --groups;
+                    }
+                }
+            }
+        }
+        // 走完的组：独立的一块，改用新编号
+        for (int g = 0; g < searches && groups > 1; ++g) {
+            if (find(g) != g || finished[g]) continue;
+            bool exhausted = true;
+            for (int i = 0; i < searches; ++i) {
+                if (find(i) == g && heads[i] != queues[i].size()) exhausted = false;
+            }
+            if (!exhausted) continue;
+            const int newLabel = static_cast<int>(componentSizes.size());
+            int count = 0;
+            for (int i = 0; i < searches; ++i) {
+                if (find(i) != g) continue;
+                for (int visited : queues[i]) componentLabels[visited] = newLabel;
+                count += static_cast<int>(queues[i].size());
+            }
+            componentSizes.push_back(count);
+            componentSizes[label] -= count;
+            ++componentCount;
+            finished[g] = true;
+            --groups;
+        }
+    }
+
+    for (int i = 0; i < searches; ++i) {
+        for (int visited : queues[i]) searchOwner[visited] = -1;
+    }
+}
+
+LevelManager::LevelManager(const std::vector<std::string>& levelPaths, int playerFrameWidth,
+    int playerFrameHeight, int playerFrameCols, int requiredRows, int requiredCols)
+    : levelPaths(levelPaths), playerFrameWidth(playerFrameWidth), playerFrameHeight(playerFrameHeight),
+    playerFrameCols(playerFrameCols), requiredRows(requiredRows), requiredCols(requiredCols),
+    currentIndex(0), lastWaitMs(0.0) {
+    if (levelPaths.empty()) {
+        throw std::runtime_error("No level files given");
+    }
+    currentLevel = loadLevel(levelPaths[0], playerFrameWidth, playerFrameHeight, playerFrameCols,
+        requiredRows, requiredCols);
+    if (hasNext()) startPreload(1, nullptr);
+}
+
+LevelManager::~LevelManager() {
+    if (pending.valid()) pending.wait();
+}
+
+std::unique_ptr<Level> LevelManager::loadLevel(const std::string& path, int width, int height, int cols,
+    int requiredRows, int requiredCols) {
+    std::unique_ptr<Level> level(new Level(path, width, height, cols));
+    const Maze& maze = level->getMaze();
+    if ((requiredRows > 0 && maze.rows != requiredRows) || (requiredCols > 0 && maze.cols != requiredCols)) {
+        throw std::runtime_error("Maze must be " + std::to_string(requiredRows) + "×" + std::to_string(requiredCols)
+            + " (task requirement)! " + path + " is " + std::to_string(maze.rows) + "×" + std::to_string(maze.cols));
+    }
+    return level;
+}
+
+void LevelManager::startPreload(size_t index, std::unique_ptr<Level> retired) {
+    const std::string path = levelPaths[index];
+    const int width = playerFrameWidth, height = playerFrameHeight, cols = playerFrameCols;
+    const int rows = requiredRows, columns = requiredCols;
+    // 旧关卡由任务在后台线程显式释放（若把unique_ptr捕获进lambda，释放时机取决于共享状态何时销毁，可能落回主线程）
+    Level* old = retired.release();
+    pending = std::async(std::launch::async, [path, width, height, cols, rows, columns, old]() {
+        delete old;
+        return loadLevel(path, width, height, cols, rows, columns);
+    });
+}
+
+const Level* LevelManager::peekNext() {
+    if (!nextLevel && pending.valid()
+        && pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        nextLevel = pending.get();
+    }
+    return nextLevel.get();
+}
+
+void LevelManager::reloadCurrent() {
+    currentLevel = loadLevel(levelPaths[currentIndex], playerFrameWidth, playerFrameHeight, playerFrameCols,
+        requiredRows, requiredCols);
+}
+
+void LevelManager::advance() {
+    if (!hasNext()) return;
+    auto begin = std::chrono::steady_clock::now();
+    if (!nextLevel) nextLevel = pending.get(); // 预加载尚未完成：只能等待
+    lastWaitMs = msSince(begin);
+
+    std::unique_ptr<Level> retired = std::move(currentLevel);
+    currentLevel = std::move(nextLevel);
+    currentIndex = (currentIndex + 1) % levelPaths.size();
+    startPreload((currentIndex + 1) % levelPaths.size(), std::move(retired));
+}
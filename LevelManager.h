@@ -0,0 +1,119 @@
+#ifndef LEVEL_MANAGER_H
+#define LEVEL_MANAGER_H
+#include "MazeParser.h"
+#include "GameSession.h"
+#include "FlowField.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <future>
+
+// 热重载时迷宫的单格改动
+struct CellChange {
+    Point cell;
+    BlockType before;
+    BlockType after;
+};
+
+// 一关的全部运行时数据（无头核心）：迷宫 + 对局（含碰撞结构）+ 预处理结果，整体可在后台线程构建。
+// session引用maze，因此Level只能通过指针持有，不可拷贝或移动
+class Level {
+public:
+    // 解析迷宫文件并完成预处理；文件或迷宫非法时抛出runtime_error
+    Level(const std::string& filePath, int playerFrameWidth, int playerFrameHeight, int playerFrameCols);
+
+    Level(const Level&) = delete;
+    Level& operator=(const Level&) = delete;
+
+    const std::string& getFilePath() const { return filePath; }
+    const Maze& getMaze() const { return maze; }
+    GameSession& getSession() { return session; }
+    const GameSession& getSession() const { return session; }
+
+    // 连通分量编号（墙为-1）：编号不同的两格之间不存在路径，无需搜索
+    int componentAt(const Point& p) const { return componentLabels[p.row * maze.cols + p.col]; }
+    int getComponentCount() const { return componentCount; }
+    // 到终点的步数距离场（FlowField，可直接沿下降方向走到终点）
+    const FlowField& getExitField() const { return exitField; }
+    // 连通分量与距离场的预处理耗时（毫秒）
+    double getBuildMs() const { return buildMs; }
+
+    // 热重载：与edited逐格比较，把改动的格子就地写入迷宫，并只更新受影响的派生数据
+    // （只改地形成本时碰撞结构、连通分量和距离场都保持不变）。
+    // 尺寸或起终点变化时不做任何修改并返回false，调用方需整关重建；changes为实际改动的格子
+    bool applyEdit(const Maze& edited, std::vector<CellChange>& changes);
+
+private:
+    // 按4邻接为所有非墙格标注连通分量
+    void labelComponents();
+    // 热重载：单格由墙变为可通行（与相邻分量合并）/ 由可通行变为墙（可能把分量切成几块）
+    void openCell(int cell);
+    void closeCell(int cell);
+    // 把from分量中与cell连通的格子全部改为to，返回改动格数
+    int relabel(int cell, int from, int to);
+
+    std::string filePath;
+    Maze maze;
+    GameSession session;
+    std::vector<int> componentLabels;
+    std::vector<int> componentSizes;    // 各编号的格数（合并/切分后废弃的编号为0）
+    std::vector<int> searchOwner;       // closeCell的搜索标记（-1为未访问，用完即复原）
+    int componentCount;                 // 现存分量数
+    FlowField exitField;
+    double buildMs;
+};
+
+// 多关卡管理：当前关卡游玩期间，下一关在后台线程解析和预处理；
+// 胜利后advance只交换指针，旧关卡也交给后台线程释放，关卡切换不在主循环里做重活。
+// 关卡按列表顺序循环；所有方法须在同一线程（主循环）调用
+class LevelManager {
+public:
+    // 同步加载第一关，然后开始预加载下一关（关卡列表为空或第一关非法时抛出异常）；
+    // requiredRows/requiredCols > 0 时每一关（含预加载与重建的关卡）都须是该尺寸，否则按非法关卡抛出异常
+    LevelManager(const std::vector<std::string>& levelPaths, int playerFrameWidth = PLAYER_FRAME_WIDTH,
+        int playerFrameHeight = PLAYER_FRAME_HEIGHT, int playerFrameCols = 3, int requiredRows = 0, int requiredCols = 0);
+    // 析构：等待后台任务结束
+    ~LevelManager();
+
+    LevelManager(const LevelManager&) = delete;
+    LevelManager& operator=(const LevelManager&) = delete;
+
+    Level& current() { return *currentLevel; }
+    const Level& current() const { return *currentLevel; }
+    size_t getCurrentIndex() const { return currentIndex; }
+    size_t getLevelCount() const { return levelPaths.size(); }
+    bool hasNext() const { return levelPaths.size() > 1; }
+
+    // 下一关已预加载完成则返回它（不阻塞，供前端提前烘焙渲染缓存），否则返回nullptr；
+    // 后台加载失败时在此抛出异常
+    const Level* peekNext();
+    // 切换到下一关：预加载已完成时只交换指针；尚未完成则等待（记入getLastWaitMs）
+    void advance();
+    // 最近一次advance等待预加载的时间（毫秒，0表示无卡顿）
+    double getLastWaitMs() const { return lastWaitMs; }
+
+    // 从文件重新构建当前关卡（同步，热重载需要整关重建时使用）；文件非法时抛出异常，当前关卡保持不变
+    void reloadCurrent();
+
+private:
+    // 在后台线程构建第index关，并顺带释放retired（上一关）
+    void startPreload(size_t index, std::unique_ptr<Level> retired);
+    // 构建一关并检查尺寸（可在后台线程调用）
+    static std::unique_ptr<Level> loadLevel(const std::string& path, int width, int height, int cols,
+        int requiredRows, int requiredCols);
+
+    std::vector<std::string> levelPaths;
+    int playerFrameWidth;
+    int playerFrameHeight;
+    int playerFrameCols;
+    int requiredRows;                              // 0表示不限
+    int requiredCols;
+
+    std::unique_ptr<Level> currentLevel;
+    size_t currentIndex;
+    std::future<std::unique_ptr<Level>> pending;   // 后台构建中的下一关
+    std::unique_ptr<Level> nextLevel;              // 已完成的下一关
+    double lastWaitMs;
+};
+
+#endif // LEVEL_MANAGER_H
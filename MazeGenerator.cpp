@@ -0,0 +1,396 @@
+#include "MazeGenerator.h"
+#include "PathFinder.h"
+#include <random>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+    const int BAND_ROWS = 64; // 逐格处理（洞穴平滑、撒地形）时每个任务负责的行数
+
+    // 各阶段的随机流编号（同一种子下各阶段、各分区互不相关）
+    enum Stage : uint32_t {
+        STAGE_CARVE = 1,
+        STAGE_STITCH = 2,
+        STAGE_BRAID = 3,
+        STAGE_CAVERN = 4,
+        STAGE_TERRAIN = 5
+    };
+
+    // 由（种子, 阶段, 任务序号）派生独立的随机种子（splitmix64终结函数），
+    // 结果只取决于任务序号而非执行线程，保证任意线程数下生成结果一致
+    uint32_t streamSeed(unsigned seed, uint32_t stage, uint32_t index) {
+        uint64_t x = static_cast<uint64_t>(seed) * 0x9E3779B97F4A7C15ull
+            + static_cast<uint64_t>(stage) * 0xD1B54A32D192ED03ull + index;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        x ^= x >> 31;
+        return static_cast<uint32_t>(x ^ (x >> 32));
+    }
+
+    // 概率 → 与32位随机数比较的阈值（rng() < threshold 即命中）
+    uint64_t chanceThreshold(double probability) {
+        if (probability <= 0.0) return 0;
+        if (probability >= 1.0) return 1ull << 32;
+        return static_cast<uint64_t>(probability * 4294967296.0);
+    }
+
+    int resolveThreads(int requested) {
+        if (requested > 0) return requested;
+        unsigned hw = std::thread::hardware_concurrency();
+        return hw > 0 ? static_cast<int>(hw) : 1;
+    }
+
+    // 简单并行循环：threadCount个线程（含当前线程）按原子计数领取[0, count)中的任务
+    template<typename Fn>
+    void parallelFor(int count, int threadCount, Fn fn) {
+        std::atomic<int> next(0);
+        std::exception_ptr error;
+        std::mutex errorMutex;
+        auto worker = [&]() {
+            for (int i = next++; i < count; i = next++) {
+                try {
+                    fn(i);
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error) error = std::current_exception();
+                    next = count;
+                }
+            }
+        };
+
+        int workers = std::min(threadCount, count);
+        std::vector<std::thread> threads;
+        for (int t = 1; t < workers; ++t) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        if (error) std::rethrow_exception(error);
+    }
+
+    // 迷宫单元（奇数坐标格）的四个方向
+    const int CELL_DIRS[4][2] = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+}
+
+// 生成迷宫
+Maze MazeGenerator::generate(const MazeGenOptions& options) {
+    if (options.rows < 5 || options.cols < 5) {
+        throw std::runtime_error("Maze too small to generate: rows=" + std::to_string(options.rows) +
+            ", cols=" + std::to_string(options.cols));
+    }
+    if (options.regionSize < 2) {
+        throw std::runtime_error("Invalid region size: " + std::to_string(options.regionSize));
+    }
+
+    Maze maze;
+    maze.rows = options.rows;
+    maze.cols = options.cols;
+    maze.mapData.assign(maze.rows, std::vector<BlockType>(maze.cols, BlockType::WALL));
+
+    if (options.style == MazeStyle::CAVERN) {
+        growCaverns(maze, options);
+        placeCavernEnds(maze);
+    }
+    else {
+        // 1. 分区并行挖掘 → 2. 拼接成一棵整体生成树（完美迷宫） → 3. 可选编织
+        carveRegions(maze, options);
+        stitchRegions(maze, options);
+        if (options.style == MazeStyle::BRAIDED) {
+            braid(maze, options);
+        }
+
+        // 起点左上第一个单元，终点右下最后一个单元
+        int cellRows = (maze.rows - 1) / 2;
+        int cellCols = (maze.cols - 1) / 2;
+        maze.mapData[1][1] = BlockType::START;
+        maze.mapData[2 * cellRows - 1][2 * cellCols - 1] = BlockType::END;
+    }
+
+    scatterTerrain(maze, options);
+    return maze;
+}
+
+// 风格名解析
+MazeStyle MazeGenerator::parseStyle(const std::string& name) {
+    if (name == "perfect") return MazeStyle::PERFECT;
+    if (name == "braided") return MazeStyle::BRAIDED;
+    if (name == "cavern")  return MazeStyle::CAVERN;
+    throw std::runtime_error("Unknown maze style: " + name);
+}
+
+// 各分区内用显式栈的深度优先挖掘（只访问本分区的单元，分区之间互不写同一格）
+void MazeGenerator::carveRegions(Maze& maze, const MazeGenOptions& options) {
+    const int cellRows = (maze.rows - 1) / 2;
+    const int cellCols = (maze.cols - 1) / 2;
+    const int size = options.regionSize;
+    const int regionRows = (cellRows + size - 1) / size;
+    const int regionCols = (cellCols + size - 1) / size;
+
+    parallelFor(regionRows * regionCols, resolveThreads(options.threadCount), [&](int region) {
+        const int r0 = region / regionCols * size, c0 = region % regionCols * size;
+        const int height = std::min(size, cellRows - r0), width = std::min(size, cellCols - c0);
+        std::mt19937 rng(streamSeed(options.seed, STAGE_CARVE, static_cast<uint32_t>(region)));
+
+        // 栈中存放分区内的局部单元序号
+        std::vector<int> stack;
+        stack.reserve(static_cast<size_t>(height) * width);
+        int first = static_cast<int>(rng() % static_cast<uint32_t>(height * width));
+        stack.push_back(first);
+        maze.mapData[2 * (r0 + first / width) + 1][2 * (c0 + first % width) + 1] = BlockType::GROUND;
+
+        while (!stack.empty()) {
+            int cur = stack.back();
+            int row = cur / width, col = cur % width;
+            int order[4] = { 0, 1, 2, 3 };
+            std::shuffle(order, order + 4, rng);
+            bool carved = false;
+            for (int k = 0; k < 4; ++k) {
+                int newRow = row + CELL_DIRS[order[k]][0];
+                int newCol = col + CELL_DIRS[order[k]][1];
+                if (newRow < 0 || newRow >= height || newCol < 0 || newCol >= width) continue;
+                BlockType& cell = maze.mapData[2 * (r0 + newRow) + 1][2 * (c0 + newCol) + 1];
+                if (cell != BlockType::WALL) continue;
+                cell = BlockType::GROUND;
+                maze.mapData[2 * (r0 + row) + 1 + CELL_DIRS[order[k]][0]][2 * (c0 + col) + 1 + CELL_DIRS[order[k]][1]] = BlockType::GROUND;
+                stack.push_back(newRow * width + newCol);
+                carved = true;
+                break;
+            }
+            if (!carved) stack.pop_back();
+        }
+    });
+}
+
+// 在分区网格上做随机深度优先生成树，每条树边在两分区的公共边界上随机开一个口；
+// 各分区内部是树、分区间也是树，拼接后整体仍是完美迷宫
+void MazeGenerator::stitchRegions(Maze& maze, const MazeGenOptions& options) {
+    const int cellRows = (maze.rows - 1) / 2;
+    const int cellCols = (maze.cols - 1) / 2;
+    const int size = options.regionSize;
+    const int regionRows = (cellRows + size - 1) / size;
+    const int regionCols = (cellCols + size - 1) / size;
+    if (regionRows * regionCols <= 1) return;
+
+    std::mt19937 rng(streamSeed(options.seed, STAGE_STITCH, 0));
+    std::vector<char> visited(static_cast<size_t>(regionRows) * regionCols, 0);
+    std::vector<int> stack;
+    stack.push_back(0);
+    visited[0] = 1;
+    while (!stack.empty()) {
+        int cur = stack.back();
+        int row = cur / regionCols, col = cur % regionCols;
+        int order[4] = { 0, 1, 2, 3 };
+        std::shuffle(order, order + 4, rng);
+        bool linked = false;
+        for (int k = 0; k < 4; ++k) {
+            int newRow = row + CELL_DIRS[order[k]][0];
+            int newCol = col + CELL_DIRS[order[k]][1];
+            if (newRow < 0 || newRow >= regionRows || newCol < 0 || newCol >= regionCols) continue;
+            int next = newRow * regionCols + newCol;
+            if (visited[next]) continue;
+
+            if (newRow != row) {
+                // 上下相邻：在公共边界（单元行boundary-1与boundary之间）随机选一列
+                int boundary = std::max(row, newRow) * size;
+                int c0 = col * size, width = std::min(size, cellCols - c0);
+                int cellCol = c0 + static_cast<int>(rng() % static_cast<uint32_t>(width));
+                maze.mapData[2 * boundary][2 * cellCol + 1] = BlockType::GROUND;
+            }
+            else {
+                int boundary = std::max(col, newCol) * size;
+                int r0 = row * size, height = std::min(size, cellRows - r0);
+                int cellRow = r0 + static_cast<int>(rng() % static_cast<uint32_t>(height));
+                maze.mapData[2 * cellRow + 1][2 * boundary] = BlockType::GROUND;
+            }
+            visited[next] = 1;
+            stack.push_back(next);
+            linked = true;
+            break;
+        }
+        if (!linked) stack.pop_back();
+    }
+}
+
+// 编织：按完美迷宫的死胡同（只有一个出口的单元）以braidRatio概率随机打通一面内墙。
+// 各分区并行只读地挑选要打通的墙，最后统一写回，避免跨分区写同一格
+void MazeGenerator::braid(Maze& maze, const MazeGenOptions& options) {
+    const int cellRows = (maze.rows - 1) / 2;
+    const int cellCols = (maze.cols - 1) / 2;
+    const int size = options.regionSize;
+    const int regionRows = (cellRows + size - 1) / size;
+    const int regionCols = (cellCols + size - 1) / size;
+    const uint64_t threshold = chanceThreshold(options.braidRatio);
+    if (threshold == 0) return;
+
+    std::vector<std::vector<Point>> openings(static_cast<size_t>(regionRows) * regionCols);
+    parallelFor(regionRows * regionCols, resolveThreads(options.threadCount), [&](int region) {
+        const int r0 = region / regionCols * size, c0 = region % regionCols * size;
+        const int r1 = std::min(r0 + size, cellRows), c1 = std::min(c0 + size, cellCols);
+        std::mt19937 rng(streamSeed(options.seed, STAGE_BRAID, static_cast<uint32_t>(region)));
+        std::vector<Point>& out = openings[region];
+
+        for (int row = r0; row < r1; ++row) {
+            for (int col = c0; col < c1; ++col) {
+                int gridRow = 2 * row + 1, gridCol = 2 * col + 1;
+                int exits = 0;
+                int closed[4];
+                int closedCount = 0;
+                for (int d = 0; d < 4; ++d) {
+                    if (maze.mapData[gridRow + CELL_DIRS[d][0]][gridCol + CELL_DIRS[d][1]] != BlockType::WALL) {
+                        ++exits;
+                        continue;
+                    }
+                    int newRow = row + CELL_DIRS[d][0], newCol = col + CELL_DIRS[d][1];
+                    if (newRow >= 0 && newRow < cellRows && newCol >= 0 && newCol < cellCols) {
+                        closed[closedCount++] = d;
+                    }
+                }
+                if (exits != 1 || closedCount == 0) continue;
+                if (static_cast<uint64_t>(rng()) >= threshold) continue;
+                int d = closed[rng() % static_cast<uint32_t>(closedCount)];
+                out.push_back({ gridRow + CELL_DIRS[d][0], gridCol + CELL_DIRS[d][1] });
+            }
+        }
+    });
+
+    for (const auto& list : openings) {
+        for (const Point& p : list) {
+            maze.mapData[p.row][p.col] = BlockType::GROUND;
+        }
+    }
+}
+
+// 洞穴：按cavernFill随机填墙，再做若干轮元胞自动机平滑（3×3邻域内墙数≥5则为墙），
+// 按行带并行，读写分离的双缓冲保证结果与线程数无关
+void MazeGenerator::growCaverns(Maze& maze, const MazeGenOptions& options) {
+    const int rows = maze.rows, cols = maze.cols;
+    const int bands = (rows + BAND_ROWS - 1) / BAND_ROWS;
+    const int threads = resolveThreads(options.threadCount);
+    const uint64_t threshold = chanceThreshold(options.cavernFill);
+
+    std::vector<uint8_t> current(static_cast<size_t>(rows) * cols, 1);
+    std::vector<uint8_t> next(current.size(), 1);
+
+    parallelFor(bands, threads, [&](int band) {
+        std::mt19937 rng(streamSeed(options.seed, STAGE_CAVERN, static_cast<uint32_t>(band)));
+        int rowEnd = std::min(rows - 1, (band + 1) * BAND_ROWS);
+        for (int row = std::max(1, band * BAND_ROWS); row < rowEnd; ++row) {
+            uint8_t* line = &current[static_cast<size_t>(row) * cols];
+            for (int col = 1; col < cols - 1; ++col) {
+                line[col] = static_cast<uint64_t>(rng()) < threshold ? 1 : 0;
+            }
+        }
+    });
+
+    for (int iteration = 0; iteration < options.cavernSmoothing; ++iteration) {
+        parallelFor(bands, threads, [&](int band) {
+            int rowEnd = std::min(rows - 1, (band + 1) * BAND_ROWS);
+            for (int row = std::max(1, band * BAND_ROWS); row < rowEnd; ++row) {
+                const uint8_t* above = &current[static_cast<size_t>(row - 1) * cols];
+                const uint8_t* line = above + cols;
+                const uint8_t* below = line + cols;
+                uint8_t* out = &next[static_cast<size_t>(row) * cols];
+                for (int col = 1; col < cols - 1; ++col) {
+                    int walls = above[col - 1] + above[col] + above[col + 1]
+                        + line[col - 1] + line[col] + line[col + 1]
+                        + below[col - 1] + below[col] + below[col + 1];
+                    out[col] = walls >= 5 ? 1 : 0;
+                }
+            }
+        });
+        current.swap(next);
+    }
+
+    parallelFor(bands, threads, [&](int band) {
+        int rowEnd = std::min(rows, (band + 1) * BAND_ROWS);
+        for (int row = band * BAND_ROWS; row < rowEnd; ++row) {
+            const uint8_t* line = &current[static_cast<size_t>(row) * cols];
+            std::vector<BlockType>& out = maze.mapData[row];
+            for (int col = 0; col < cols; ++col) {
+                out[col] = line[col] ? BlockType::WALL : BlockType::GROUND;
+            }
+        }
+    });
+}
+
+// 洞穴起终点：起点取最靠左上的通路格，从起点广度优先，终点取可达格中最靠右下者；
+// 与起点不连通的空腔填成墙，保证整张图只有一块连通区域。
+// 若起点附近无路可走（填充率过高），从起点挖一条L形通道到右下角再重新搜索
+void MazeGenerator::placeCavernEnds(Maze& maze) {
+    const int rows = maze.rows, cols = maze.cols;
+    Point start = { -1, -1 };
+    for (int diagonal = 2; diagonal <= rows + cols - 4 && start.row < 0; ++diagonal) {
+        for (int row = std::max(1, diagonal - (cols - 2)); row <= std::min(rows - 2, diagonal - 1); ++row) {
+            if (maze.mapData[row][diagonal - row] == BlockType::GROUND) {
+                start = { row, diagonal - row };
+                break;
+            }
+        }
+    }
+    if (start.row < 0) {
+        start = { 1, 1 };
+        maze.mapData[1][1] = BlockType::GROUND;
+    }
+
+    std::vector<uint8_t> reached;
+    std::vector<int> queue;
+    Point end = start;
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        reached.assign(static_cast<size_t>(rows) * cols, 0);
+        queue.clear();
+        queue.push_back(start.row * cols + start.col);
+        reached[queue.back()] = 1;
+        end = start;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int row = queue[head] / cols, col = queue[head] % cols;
+            if (row + col > end.row + end.col) end = { row, col };
+            for (int d = 0; d < 4; ++d) {
+                int newRow = row + CELL_DIRS[d][0], newCol = col + CELL_DIRS[d][1];
+                int index = newRow * cols + newCol;
+                if (reached[index] || maze.mapData[newRow][newCol] == BlockType::WALL) continue;
+                reached[index] = 1;
+                queue.push_back(index);
+            }
+        }
+        if (end.row != start.row || end.col != start.col) break;
+
+        for (int row = start.row; row <= rows - 2; ++row) maze.mapData[row][start.col] = BlockType::GROUND;
+        for (int col = start.col; col <= cols - 2; ++col) maze.mapData[rows - 2][col] = BlockType::GROUND;
+    }
+
+    for (int row = 1; row < rows - 1; ++row) {
+        for (int col = 1; col < cols - 1; ++col) {
+            if (!reached[static_cast<size_t>(row) * cols + col]) maze.mapData[row][col] = BlockType::WALL;
+        }
+    }
+    maze.mapData[start.row][start.col] = BlockType::START;
+    maze.mapData[end.row][end.col] = BlockType::END;
+}
+
+// 撒草地/熔岩：按行带并行，只替换普通地面（不覆盖起终点）
+void MazeGenerator::scatterTerrain(Maze& maze, const MazeGenOptions& options) {
+    const uint64_t grass = chanceThreshold(options.grassDensity);
+    const uint64_t lava = std::min<uint64_t>(1ull << 32, grass + chanceThreshold(options.lavaDensity));
+    if (lava == 0) return;
+
+    const int bands = (maze.rows + BAND_ROWS - 1) / BAND_ROWS;
+    parallelFor(bands, resolveThreads(options.threadCount), [&](int band) {
+        std::mt19937 rng(streamSeed(options.seed, STAGE_TERRAIN, static_cast<uint32_t>(band)));
+        int rowEnd = std::min(maze.rows, (band + 1) * BAND_ROWS);
+        for (int row = band * BAND_ROWS; row < rowEnd; ++row) {
+            for (BlockType& cell : maze.mapData[row]) {
+                if (cell != BlockType::GROUND) continue;
+                uint64_t roll = rng();
+                if (roll < grass) cell = BlockType::GRASS;
+                else if (roll < lava) cell = BlockType::LAVA;
+            }
+        }
+    });
+}
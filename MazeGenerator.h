@@ -0,0 +1,45 @@
+#ifndef MAZE_GENERATOR_H
+#define MAZE_GENERATOR_H
+#include "MazeParser.h"
+#include <string>
+
+// 迷宫风格
+enum class MazeStyle {
+    PERFECT,   // 完美迷宫：任意两点间只有一条路
+    BRAIDED,   // 编织迷宫：打通部分死胡同形成回路
+    CAVERN     // 开阔洞穴：元胞自动机平滑出的不规则空间
+};
+
+// 生成参数（相同参数+种子 → 逐格相同的迷宫，与线程数无关）
+struct MazeGenOptions {
+    int rows = 21;
+    int cols = 21;
+    MazeStyle style = MazeStyle::PERFECT;
+    unsigned seed = 1;
+    double braidRatio = 0.5;      // 编织迷宫：被打通的死胡同比例
+    double cavernFill = 0.45;     // 洞穴：初始墙体比例
+    int cavernSmoothing = 4;      // 洞穴：平滑轮数
+    double grassDensity = 0.0;    // 通路格变为草地的概率
+    double lavaDensity = 0.0;     // 通路格变为熔岩的概率
+    int regionSize = 128;         // 分区边长（迷宫单元数），各分区独立生成后拼接
+    int threadCount = 0;          // 工作线程数（0=按CPU核数）
+};
+
+// 程序化迷宫生成器：按分区并行生成，再用分区间的生成树打通边界拼接成整体
+// 起点固定放在左上、终点放在右下（洞穴风格取与起点连通且最靠右下的格子）
+class MazeGenerator {
+public:
+    static Maze generate(const MazeGenOptions& options);
+    // "perfect" / "braided" / "cavern" → MazeStyle（未知名称抛异常）
+    static MazeStyle parseStyle(const std::string& name);
+
+private:
+    static void carveRegions(Maze& maze, const MazeGenOptions& options);    // 各分区内深度优先挖掘
+    static void stitchRegions(Maze& maze, const MazeGenOptions& options);   // 分区间按生成树各开一个口
+    static void braid(Maze& maze, const MazeGenOptions& options);           // 打通死胡同
+    static void growCaverns(Maze& maze, const MazeGenOptions& options);     // 随机填充+平滑
+    static void placeCavernEnds(Maze& maze);                                // 洞穴起终点+去除孤立空腔
+    static void scatterTerrain(Maze& maze, const MazeGenOptions& options);  // 撒草地/熔岩
+};
+
+#endif // MAZE_GENERATOR_H
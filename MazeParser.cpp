@@ -1,23 +1,54 @@
 #include "MazeParser.h"
 #include <fstream>
 #include <sstream>
+#include <cstdint>
+#include <cstring>
 
-// ļԹ
+namespace {
+    const char MAP_MAGIC[4] = { 'M', 'Z', 'M', 'P' };
+    const uint32_t MAP_VERSION = 1;
+
+    // 按小端字节序写入/读取（与InputLog一致）
+    void writeU32(std::ofstream& out, uint32_t value) {
+        char bytes[4] = {
+            static_cast<char>(value & 0xFF), static_cast<char>((value >> 8) & 0xFF),
+            static_cast<char>((value >> 16) & 0xFF), static_cast<char>((value >> 24) & 0xFF)
+        };
+        out.write(bytes, 4);
+    }
+
+    uint32_t readU32(std::ifstream& in) {
+        unsigned char bytes[4] = { 0, 0, 0, 0 };
+        in.read(reinterpret_cast<char*>(bytes), 4);
+        return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+    }
+}
+
+// 从文件加载迷宫数据
 Maze MazeParser::loadFromFile(const std::string& filePath) {
     Maze maze;
-    std::ifstream file(filePath);
+    std::ifstream file(filePath, std::ios::binary);
     if (!file.is_open()) {
         throw std::runtime_error("Failed to open maze file: " + filePath);
     }
 
-    // һȡһУ
+    // 二进制格式：按magic识别
+    char magic[4] = { 0, 0, 0, 0 };
+    file.read(magic, 4);
+    if (file.gcount() == 4 && std::memcmp(magic, MAP_MAGIC, 4) == 0) {
+        return loadBinary(file, filePath);
+    }
+    file.clear();
+    file.seekg(0);
+
+    // 第一步：读取行数和列数（第一行）
     file >> maze.rows >> maze.cols;
     if (maze.rows <= 0 || maze.cols <= 0) {
         throw std::runtime_error("Invalid maze size: rows=" + std::to_string(maze.rows) +
             ", cols=" + std::to_string(maze.cols));
     }
 
-    // ڶȡؿ
+    // 第二步：读取后续地块数据
     maze.mapData.resize(maze.rows, std::vector<BlockType>(maze.cols));
     int num;
     for (int row = 0; row < maze.rows; ++row) {
@@ -34,7 +65,87 @@ Maze MazeParser::loadFromFile(const std::string& filePath) {
     return maze;
 }
 
-// תؿ
+// 读取二进制格式
+Maze MazeParser::loadBinary(std::ifstream& file, const std::string& filePath) {
+    uint32_t version = readU32(file);
+    if (version != MAP_VERSION) {
+        throw std::runtime_error("Unsupported maze file version " + std::to_string(version) + ": " + filePath);
+    }
+
+    Maze maze;
+    uint32_t rows = readU32(file);
+    uint32_t cols = readU32(file);
+    if (!file || rows == 0 || cols == 0 || rows > 1u << 16 || cols > 1u << 16) {
+        throw std::runtime_error("Invalid maze size in binary file: " + filePath);
+    }
+    maze.rows = static_cast<int>(rows);
+    maze.cols = static_cast<int>(cols);
+
+    // 逐行读取一整行字节再转换
+    maze.mapData.resize(maze.rows, std::vector<BlockType>(maze.cols));
+    std::vector<signed char> line(maze.cols);
+    for (int row = 0; row < maze.rows; ++row) {
+        if (!file.read(reinterpret_cast<char*>(line.data()), maze.cols)) {
+            throw std::runtime_error("Maze data incomplete at row=" + std::to_string(row) + ": " + filePath);
+        }
+        for (int col = 0; col < maze.cols; ++col) {
+            maze.mapData[row][col] = numToBlockType(line[col]);
+        }
+    }
+    return maze;
+}
+
+// 按文本格式写出（每行先拼成字符串再一次写入，大迷宫也能快速输出）
+void MazeParser::saveToFile(const Maze& maze, const std::string& filePath) {
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to write maze file: " + filePath);
+    }
+
+    file << maze.rows << " " << maze.cols << "\n";
+    std::string line;
+    for (int row = 0; row < maze.rows; ++row) {
+        line.clear();
+        for (int col = 0; col < maze.cols; ++col) {
+            int num = static_cast<int>(maze.mapData[row][col]);
+            if (num < 0) {
+                line += '-';
+                num = -num;
+            }
+            line += static_cast<char>('0' + num);
+            line += col + 1 < maze.cols ? ' ' : '\n';
+        }
+        file.write(line.data(), line.size());
+    }
+    if (!file) {
+        throw std::runtime_error("Failed to write maze file: " + filePath);
+    }
+}
+
+// 按二进制格式写出
+void MazeParser::saveBinaryFile(const Maze& maze, const std::string& filePath) {
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to write maze file: " + filePath);
+    }
+
+    file.write(MAP_MAGIC, 4);
+    writeU32(file, MAP_VERSION);
+    writeU32(file, static_cast<uint32_t>(maze.rows));
+    writeU32(file, static_cast<uint32_t>(maze.cols));
+    std::vector<signed char> line(maze.cols);
+    for (int row = 0; row < maze.rows; ++row) {
+        for (int col = 0; col < maze.cols; ++col) {
+            line[col] = static_cast<signed char>(maze.mapData[row][col]);
+        }
+        file.write(reinterpret_cast<const char*>(line.data()), line.size());
+    }
+    if (!file) {
+        throw std::runtime_error("Failed to write maze file: " + filePath);
+    }
+}
+
+// 数字转地块类型
 BlockType MazeParser::numToBlockType(int num) {
     switch (num) {
     case 1:  return BlockType::WALL;
@@ -3,37 +3,45 @@
 #include <string>
 #include <vector>
 #include <stdexcept>
+#include <iosfwd>
 
-// ؿö٣maze0.txtеֶӦ
+// 地块类型枚举（与maze0.txt中的数字对应）
 enum class BlockType {
-    WALL = 1,        // ǽ
-    START = -1,      // 
-    GROUND = 0,      // ͨ
-    END = -2,        // յ
-    GRASS = 2,       // ݵ
-    LAVA = 3         // 
+    WALL = 1,        // 墙
+    START = -1,      // 起点
+    GROUND = 0,      // 普通地面
+    END = -2,        // 终点
+    GRASS = 2,       // 草地
+    LAVA = 3         // 熔岩
 };
 
-// Թࣨװؿݣ
+// 迷宫数据类（封装行数、列数、地块数据）
 class Maze {
 public:
-    int rows;                  // Թ
-    int cols;                  // Թ
-    std::vector<std::vector<BlockType>> mapData; // άؿ
+    int rows;                  // 迷宫行数
+    int cols;                  // 迷宫列数
+    std::vector<std::vector<BlockType>> mapData; // 二维地块数据
 
-    // /
+    // 构造/析构
     Maze() : rows(0), cols(0) {}
     ~Maze() = default;
 };
 
-// Թļ
+// 迷宫文件解析类
 class MazeParser {
 public:
-    // ̬ļԹݣC++11ϣ
+    // 静态方法：从文件加载迷宫数据（C++11及以上）
+    // 文件以"MZMP"开头时按二进制格式读取，否则按maze0.txt的文本格式读取
     static Maze loadFromFile(const std::string& filePath);
+    // 按文本格式写出迷宫（首行行列数，之后每行空格分隔的地块数字）
+    static void saveToFile(const Maze& maze, const std::string& filePath);
+    // 按二进制格式写出迷宫：magic "MZMP" + 版本 + 行数 + 列数（u32小端）+ 每格1字节地块数字
+    static void saveBinaryFile(const Maze& maze, const std::string& filePath);
 
 private:
-    // ļеתΪBlockType
+    // 读取二进制格式（file已越过magic）
+    static Maze loadBinary(std::ifstream& file, const std::string& filePath);
+    // 辅助方法：将文件中的数字转换为BlockType
     static BlockType numToBlockType(int num);
 };
 
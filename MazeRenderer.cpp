@@ -1,6 +1,7 @@
 #include "MazeRenderer.h"
+#include <algorithm>
 
-// ؿĻ꣨colXᣬrowYᣩ
+// 计算地块的绘制坐标（col→X轴，row→Y轴）
 Vector2 MazeRenderer::getBlockPosition(int row, int col) {
     return {
         static_cast<float>(col * MazeRenderer::BLOCK_SIZE),
@@ -8,15 +9,71 @@ Vector2 MazeRenderer::getBlockPosition(int row, int col) {
     };
 }
 
-// ԹĹܣ
+// 绘制整个迷宫（纹理，基础任务核心功能）
 void MazeRenderer::drawMaze(const Maze& maze, const TextureManager& texManager) {
     for (int row = 0; row < maze.rows; ++row) {
         for (int col = 0; col < maze.cols; ++col) {
             BlockType type = maze.mapData[row][col];
-            Texture2D tex = texManager.getTexture(type);
+            const Texture2D& tex = texManager.getTexture(type);
             Vector2 pos = getBlockPosition(row, col);
-            // Raylib APIDrawTextureint꣬ת
+            // 修正Raylib API参数：DrawTexture接受int坐标，避免类型转换警告
             DrawTexture(tex, static_cast<int>(pos.x), static_cast<int>(pos.y), WHITE);
         }
     }
-}
\ No newline at end of file
+}
+
+// 烘焙渲染缓存
+RenderTexture2D MazeRenderer::bakeMaze(const Maze& maze, const TextureManager& texManager) {
+    RenderTexture2D cache = LoadRenderTexture(maze.cols * BLOCK_SIZE, maze.rows * BLOCK_SIZE);
+    BeginTextureMode(cache);
+    ClearBackground(RAYWHITE); // 与窗口背景一致，缓存不透明，局部重绘时可直接覆盖
+    drawMaze(maze, texManager);
+    EndTextureMode();
+    return cache;
+}
+
+// 重绘改动的格子：先用背景色盖住旧地块（地块纹理可能带透明像素），再画新地块
+void MazeRenderer::patchBaked(const RenderTexture2D& cache, const Maze& maze, const TextureManager& texManager,
+    const std::vector<Point>& cells) {
+    BeginTextureMode(cache);
+    for (const Point& p : cells) {
+        Vector2 pos = getBlockPosition(p.row, p.col);
+        DrawRectangle(static_cast<int>(pos.x), static_cast<int>(pos.y), BLOCK_SIZE, BLOCK_SIZE, RAYWHITE);
+        DrawTexture(texManager.getTexture(maze.mapData[p.row][p.col]), static_cast<int>(pos.x), static_cast<int>(pos.y), WHITE);
+    }
+    EndTextureMode();
+}
+
+// 绘制渲染缓存
+void MazeRenderer::drawBaked(const RenderTexture2D& cache) {
+    Rectangle source = { 0.0f, 0.0f, (float)cache.texture.width, -(float)cache.texture.height };
+    DrawTextureRec(cache.texture, source, Vector2{ 0, 0 }, WHITE);
+}
+
+// 绘制战争迷雾
+void MazeRenderer::drawFog(const FieldOfView& fov) {
+    const Color hiddenColor = Fade(BLACK, 0.6f);
+    const int rowEnd = std::min(fov.getRows(), GetScreenHeight() / BLOCK_SIZE + 1);
+    const int colEnd = std::min(fov.getCols(), GetScreenWidth() / BLOCK_SIZE + 1);
+    for (int row = 0; row < rowEnd; ++row) {
+        int runStart = 0, runState = 2; // 当前连续段的起始列和状态（0未探索，1已探索不可见，2可见）
+        for (int col = 0; col <= colEnd; ++col) {
+            int state = 2;
+            if (col < colEnd) {
+                // 整字可见且前面没有未收尾的遮盖段：直接跳过这64格
+                if ((col & 63) == 0 && col + 64 <= colEnd && fov.visibleWord(row, col >> 6) == ~uint64_t(0) && runState == 2) {
+                    col += 63;
+                    continue;
+                }
+                state = fov.isVisible(row, col) ? 2 : fov.isExplored(row, col) ? 1 : 0;
+            }
+            if (state == runState) continue;
+            if (runState != 2) {
+                DrawRectangle(runStart * BLOCK_SIZE, row * BLOCK_SIZE, (col - runStart) * BLOCK_SIZE, BLOCK_SIZE,
+                    runState == 0 ? BLACK : hiddenColor);
+            }
+            runStart = col;
+            runState = state;
+        }
+    }
+}
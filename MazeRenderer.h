@@ -3,19 +3,34 @@
 #include "MazeParser.h"
 #include "TextureManager.h"
 #include "PathFinder.h"
+#include "GameTypes.h"
+#include "FieldOfView.h"
 #include "raylib.h"
 #include <vector>
 #include <iostream>
 
-// Թࣨװ߼
+// 迷宫绘制类（封装绘制逻辑）
 class MazeRenderer {
 public:
-    static const int BLOCK_SIZE = 32; // ؿسߴ磨3232
+    static const int BLOCK_SIZE = TILE_SIZE; // 单个地块像素尺寸（32×32，与核心逻辑一致）
 
-    // ԹĹܣ
+    // 绘制整个迷宫（纹理，核心功能）
     static void drawMaze(const Maze& maze, const TextureManager& texManager);
 
-    // ؿĻ꣨colXrowY
+    // 渲染缓存：把整张迷宫预先绘制到渲染纹理，之后每帧只需一次绘制调用
+    // （须在主线程、BeginDrawing/EndDrawing之外调用；返回的纹理由调用方UnloadRenderTexture）
+    static RenderTexture2D bakeMaze(const Maze& maze, const TextureManager& texManager);
+    // 热重载：只重绘渲染缓存中改动的格子（调用约束同bakeMaze）
+    static void patchBaked(const RenderTexture2D& cache, const Maze& maze, const TextureManager& texManager,
+        const std::vector<Point>& cells);
+    // 绘制渲染缓存（渲染纹理上下颠倒，源矩形高度取负）
+    static void drawBaked(const RenderTexture2D& cache);
+
+    // 战争迷雾：在屏幕范围内给未探索的格子盖黑块、已探索但当前不可见的格子盖半透明暗色
+    // （同一行相邻同状态的格子合并为一个矩形；整字全可见的64格直接跳过）
+    static void drawFog(const FieldOfView& fov);
+
+    // 辅助方法：计算地块的绘制坐标（col→X，row→Y）
     static Vector2 getBlockPosition(int row, int col);
 };
 
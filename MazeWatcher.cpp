@@ -0,0 +1,59 @@
+#include "MazeWatcher.h"
+#include "AssetCache.h"
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+MazeWatcher::MazeWatcher(const std::string& filePath)
+    : filePath(filePath), inotifyFd(-1), lastMtime(0), lastSize(0) {
+    size_t slash = filePath.find_last_of("/\\");
+    std::string dir = slash == std::string::npos ? "." : filePath.substr(0, slash);
+    fileName = slash == std::string::npos ? filePath : filePath.substr(slash + 1);
+#ifdef __linux__
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd >= 0 && inotify_add_watch(inotifyFd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        close(inotifyFd);
+        inotifyFd = -1;
+    }
+#else
+    (void)dir;
+#endif
+    AssetCache::stampOf(filePath, lastMtime, lastSize);
+}
+
+MazeWatcher::~MazeWatcher() {
+#ifdef __linux__
+    if (inotifyFd >= 0) close(inotifyFd);
+#endif
+}
+
+bool MazeWatcher::poll() {
+#ifdef __linux__
+    if (inotifyFd >= 0) {
+        // 一次读空所有排队的事件（同一次保存可能产生多条），只要有一条是本文件即算改动
+        bool changed = false;
+        alignas(struct inotify_event) char buffer[4096];
+        while (true) {
+            ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+            if (length <= 0) break;
+            for (ssize_t offset = 0; offset < length;) {
+                const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(buffer + offset);
+                if (event->len > 0 && fileName == event->name) changed = true;
+                offset += sizeof(struct inotify_event) + event->len;
+            }
+        }
+        return changed;
+    }
+#endif
+    return pollStamp();
+}
+
+bool MazeWatcher::pollStamp() {
+    uint64_t mtime = 0, size = 0;
+    if (!AssetCache::stampOf(filePath, mtime, size)) return false; // 保存过程中文件可能暂时不存在
+    if (mtime == lastMtime && size == lastSize) return false;
+    lastMtime = mtime;
+    lastSize = size;
+    return true;
+}
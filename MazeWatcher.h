@@ -0,0 +1,31 @@
+#ifndef MAZE_WATCHER_H
+#define MAZE_WATCHER_H
+#include <string>
+#include <cstdint>
+
+// 迷宫文件监视（热重载用）：Linux上用inotify监视文件所在目录，
+// 直接改写和“写临时文件再改名”两种保存方式都能识别；其他平台（或inotify不可用时）退化为比较修改时间（纳秒级，与AssetCache::stampOf相同）和大小
+class MazeWatcher {
+public:
+    explicit MazeWatcher(const std::string& filePath);
+    ~MazeWatcher();
+
+    MazeWatcher(const MazeWatcher&) = delete;
+    MazeWatcher& operator=(const MazeWatcher&) = delete;
+
+    // 文件自上次调用以来是否被改写（非阻塞，每帧调用即可）
+    bool poll();
+    const std::string& getFilePath() const { return filePath; }
+
+private:
+    // 退化模式：读取修改时间和大小，与上次比较
+    bool pollStamp();
+
+    std::string filePath;
+    std::string fileName;   // 目录事件中按文件名过滤
+    int inotifyFd;          // -1表示使用退化模式
+    uint64_t lastMtime;     // 纳秒（Windows上为FILETIME）
+    uint64_t lastSize;
+};
+
+#endif // MAZE_WATCHER_H
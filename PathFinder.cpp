@@ -1,13 +1,76 @@
 #include "PathFinder.h"
 #include <algorithm>
 #include <stdexcept>
+#include <chrono>
+
+namespace {
+    // 空统计策略：所有钩子为空操作
+    struct NoStats {
+        static const bool ENABLED = false;
+        void onExpand() {}
+        void onPush(size_t) {}
+        void onStalePop() {}
+        void onDepth(size_t) {}
+        void finish(size_t, size_t) {}
+    };
+
+    // 计数策略：写入调用方传入的SearchStats
+    struct CountingStats {
+        static const bool ENABLED = true;
+        explicit CountingStats(SearchStats& out) : out(out), begin(std::chrono::steady_clock::now()) {
+            out = SearchStats();
+        }
+        void onExpand() { ++out.nodesExpanded; }
+        void onPush(size_t frontier) {
+            ++out.nodesPushed;
+            if (frontier > out.peakFrontier) out.peakFrontier = frontier;
+        }
+        void onStalePop() { ++out.stalePops; }
+        void onDepth(size_t depth) {
+            if (depth > out.peakFrontier) out.peakFrontier = depth;
+        }
+        // fixedBytes：映射表、访问标记等的占用；frontierElemBytes：队列单个元素大小（按峰值长度计）
+        void finish(size_t fixedBytes, size_t frontierElemBytes) {
+            out.bytesAllocated = fixedBytes + out.peakFrontier * frontierElemBytes;
+            out.wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        }
+
+        SearchStats& out;
+        std::chrono::steady_clock::time_point begin;
+    };
+
+    // 可取消策略：每扩展256个节点检查一次取消标志
+    struct CancellableStats : NoStats {
+        explicit CancellableStats(const std::atomic<bool>& flag) : flag(flag), expanded(0) {}
+        void onExpand() {
+            if ((++expanded & 255u) == 0 && flag.load(std::memory_order_relaxed)) {
+                throw SearchCancelled();
+            }
+        }
+
+        const std::atomic<bool>& flag;
+        unsigned expanded;
+    };
+
+    // unordered_map估算：每个节点（键值+next指针+缓存哈希）+ 桶数组
+    template<typename Map>
+    size_t mapBytes(const Map& map) {
+        return map.size() * (sizeof(typename Map::value_type) + 2 * sizeof(void*)) + map.bucket_count() * sizeof(void*);
+    }
+
+    size_t visitedBytes(const std::vector<std::vector<bool>>& visited) {
+        size_t bytes = visited.capacity() * sizeof(std::vector<bool>);
+        for (const auto& row : visited) bytes += (row.size() + 7) / 8;
+        return bytes;
+    }
+}
 
-// 죺ʼԹ/յ㣨δʼ⣩
+// 构造：初始化迷宫并查找起点/终点（修正未初始化问题）
 PathFinder::PathFinder(const Maze& maze)
     : maze(maze),
-    startPoint({ -1, -1 }),  // ʼΪЧ꣬δʼ
+    startPoint({ -1, -1 }),  // 初始化为无效坐标，避免未初始化
     endPoint({ -1, -1 }) {
-    // Թյ
+    // 遍历迷宫查找起点和终点
     for (int row = 0; row < maze.rows; ++row) {
         for (int col = 0; col < maze.cols; ++col) {
             if (maze.mapData[row][col] == BlockType::START) {
@@ -19,48 +82,123 @@ PathFinder::PathFinder(const Maze& maze)
         }
     }
 
-    // յǷڣ߼
+    // 检查起点和终点是否存在（避免后续逻辑崩溃）
     if (startPoint.row == -1 || endPoint.row == -1) {
         throw std::runtime_error("Maze must contain both start (-1) and end (-2) points!");
     }
 }
 
-// ϷԼ飺ǷԹΧҷǽ
+// 合法性检查：坐标是否在迷宫范围内且非墙
 bool PathFinder::isLegal(int row, int col) const {
     if (row < 0 || row >= maze.rows || col < 0 || col >= maze.cols) {
-        return false; // Խ
+        return false; // 越界
     }
-    return maze.mapData[row][col] != BlockType::WALL; // ǽ
+    return maze.mapData[row][col] != BlockType::WALL; // 非墙
 }
 
-// ɱ㣺ݵؿͷƶɱҪ
+// 成本计算：根据地块类型返回移动成本（基础任务要求）
 int PathFinder::getCost(int row, int col) const {
-    BlockType type = maze.mapData[row][col];
+    return tileCost(maze.mapData[row][col]);
+}
+
+// 地块成本表（其他搜索引擎共用，保证成本模型一致）
+int PathFinder::tileCost(BlockType type) {
     switch (type) {
-    case BlockType::GROUND:  return 1;    // ͨ棺ɱ1
-    case BlockType::GRASS:   return 3;    // ݵأɱ3Ҫ
-    case BlockType::LAVA:    return 1000; // ңɱ1000Ҫ
+    case BlockType::GROUND:  return 1;    // 普通地面：成本1
+    case BlockType::GRASS:   return 3;    // 草地：成本≥3（任务要求）
+    case BlockType::LAVA:    return 1000; // 熔岩：成本≥1000（任务要求）
     case BlockType::START:
-    case BlockType::END:     return 1;    // /յ㣺ɱ1
-    default:                 return INT_MAX; // Ƿؿ飨ǽɱ
+    case BlockType::END:     return 1;    // 起点/终点：成本1
+    default:                 return INT_MAX; // 非法地块（墙）：成本无穷大
     }
 }
 
-// 1. DFSҳпɴյ·
-std::vector<std::vector<Point>> PathFinder::findAllPathsByDFS() {
+// 公开接口：不带统计的版本使用空策略，带统计的版本使用计数策略
+std::vector<std::vector<Point>> PathFinder::findAllPathsByDFS(size_t maxPaths) {
+    NoStats stats;
+    return dfsSearch(stats, maxPaths);
+}
+
+std::vector<std::vector<Point>> PathFinder::findAllPathsByDFS(SearchStats& stats, size_t maxPaths) {
+    CountingStats counter(stats);
+    return dfsSearch(counter, maxPaths);
+}
+
+std::vector<Point> PathFinder::findShortestPathByBFS() {
+    NoStats stats;
+    return bfsSearch(stats, startPoint, endPoint);
+}
+
+std::vector<Point> PathFinder::findShortestPathByBFS(SearchStats& stats) {
+    CountingStats counter(stats);
+    return bfsSearch(counter, startPoint, endPoint);
+}
+
+std::vector<Point> PathFinder::findShortestPathByDijkstra() {
+    NoStats stats;
+    return dijkstraSearch(stats, startPoint, endPoint);
+}
+
+std::vector<Point> PathFinder::findShortestPathByDijkstra(SearchStats& stats) {
+    CountingStats counter(stats);
+    return dijkstraSearch(counter, startPoint, endPoint);
+}
+
+std::vector<Point> PathFinder::findShortestPathWithOneLava() {
+    NoStats stats;
+    return oneLavaSearch(stats, startPoint, endPoint);
+}
+
+std::vector<Point> PathFinder::findShortestPathWithOneLava(SearchStats& stats) {
+    CountingStats counter(stats);
+    return oneLavaSearch(counter, startPoint, endPoint);
+}
+
+// 任意起终点查询：按算法分派，有取消标志时使用可取消策略
+std::vector<Point> PathFinder::findPath(SearchAlgorithm algorithm, const Point& start, const Point& goal,
+    const std::atomic<bool>* cancelFlag) {
+    if (!isLegal(start.row, start.col) || !isLegal(goal.row, goal.col)) {
+        throw std::runtime_error("Path query endpoint is outside the maze or inside a wall");
+    }
+    if (cancelFlag != nullptr) {
+        CancellableStats stats(*cancelFlag);
+        switch (algorithm) {
+        case SearchAlgorithm::BFS:      return bfsSearch(stats, start, goal);
+        case SearchAlgorithm::DIJKSTRA: return dijkstraSearch(stats, start, goal);
+        default:                        return oneLavaSearch(stats, start, goal);
+        }
+    }
+    NoStats stats;
+    switch (algorithm) {
+    case SearchAlgorithm::BFS:      return bfsSearch(stats, start, goal);
+    case SearchAlgorithm::DIJKSTRA: return dijkstraSearch(stats, start, goal);
+    default:                        return oneLavaSearch(stats, start, goal);
+    }
+}
+
+// 1. 基础任务：DFS找出所有可达终点的路径
+template<typename Stats>
+std::vector<std::vector<Point>> PathFinder::dfsSearch(Stats& stats, size_t maxPaths) {
     std::vector<std::vector<Point>> allPaths;
     std::vector<Point> curPath;
-    // ʱǣظͬһؿ
+    // 访问标记：避免重复访问同一地块
     std::vector<std::vector<bool>> visited(maze.rows, std::vector<bool>(maze.cols, false));
 
-    // ʼ
+    // 起点初始化
     curPath.push_back(startPoint);
     visited[startPoint.row][startPoint.col] = true;
+    stats.onPush(curPath.size());
+
+    // 递归遍历所有路径
+    dfsHelper(startPoint.row, startPoint.col, curPath, visited, allPaths, maxPaths, stats);
 
-    // ݹ·
-    dfsHelper(startPoint.row, startPoint.col, curPath, visited, allPaths);
+    if (Stats::ENABLED) {
+        size_t pathBytes = allPaths.capacity() * sizeof(std::vector<Point>);
+        for (const auto& path : allPaths) pathBytes += path.capacity() * sizeof(Point);
+        stats.finish(visitedBytes(visited) + curPath.capacity() * sizeof(Point) + pathBytes, 0);
+    }
 
-    // ·׳쳣ڵԣ
+    // 若无路径，抛出异常（便于调试）
     if (allPaths.empty()) {
         throw std::runtime_error("No path found from start to end!");
     }
@@ -68,98 +206,114 @@ std::vector<std::vector<Point>> PathFinder::findAllPathsByDFS() {
     return allPaths;
 }
 
-// DFSݹ鸨
+// DFS递归辅助函数
+template<typename Stats>
 void PathFinder::dfsHelper(int row, int col, std::vector<Point>& curPath,
     std::vector<std::vector<bool>>& visited,
-    std::vector<std::vector<Point>>& allPaths) {
+    std::vector<std::vector<Point>>& allPaths, size_t maxPaths, Stats& stats) {
+
+    // 已达到路径数量上限，停止搜索
+    if (maxPaths > 0 && allPaths.size() >= maxPaths) return;
+    stats.onExpand();
+    stats.onDepth(curPath.size());
 
-    // ֹյ㣬浱ǰ·
+    // 终止条件：到达终点，保存当前路径
     if (row == endPoint.row && col == endPoint.col) {
         allPaths.push_back(curPath);
         return;
     }
 
-    // ĸ
+    // 遍历四个方向
     for (const auto& dir : dirs) {
         int newRow = row + dir[0];
         int newCol = col + dir[1];
 
-        // ؿϷδʣݹ
+        // 若地块合法且未访问，递归遍历
         if (isLegal(newRow, newCol) && !visited[newRow][newCol]) {
             visited[newRow][newCol] = true;
             curPath.push_back({ newRow, newCol });
-            dfsHelper(newRow, newCol, curPath, visited, allPaths);
-            curPath.pop_back();         // ݣƳǰؿ
-            visited[newRow][newCol] = false; // ݣȡʱ
+            stats.onPush(0);
+            dfsHelper(newRow, newCol, curPath, visited, allPaths, maxPaths, stats);
+            curPath.pop_back();         // 回溯：移除当前地块
+            visited[newRow][newCol] = false; // 回溯：取消访问标记
         }
     }
 }
 
-// 2. BFSҳ·Ȩͼ٣
-std::vector<Point> PathFinder::findShortestPathByBFS() {
-    std::unordered_map<Point, Point> prev; // ǰڵӳ䣺ڻ·
-    std::queue<Point> q;                  // BFS
+// 2. 基础任务：BFS找出最短路径（无权图，步数最少）
+template<typename Stats>
+std::vector<Point> PathFinder::bfsSearch(Stats& stats, const Point& start, const Point& goal) {
+    std::unordered_map<Point, Point> prev; // 前驱节点映射：用于回溯路径
+    std::queue<Point> q;                  // BFS队列
     std::vector<std::vector<bool>> visited(maze.rows, std::vector<bool>(maze.cols, false));
 
-    // ʼ
-    q.push(startPoint);
-    visited[startPoint.row][startPoint.col] = true;
+    // 起点初始化
+    q.push(start);
+    visited[start.row][start.col] = true;
+    stats.onPush(q.size());
 
     while (!q.empty()) {
         Point cur = q.front();
         q.pop();
 
-        // ֹյ㣬·
-        if (cur == endPoint) {
+        // 终止条件：到达终点，回溯路径
+        if (cur == goal) {
+            if (Stats::ENABLED) stats.finish(mapBytes(prev) + visitedBytes(visited), sizeof(Point));
             std::vector<Point> path;
             Point temp = cur;
             while (true) {
                 path.push_back(temp);
-                if (temp == startPoint) break;
+                if (temp == start) break;
 
-                // ǰڵ㣬˵·
+                // 若无前驱节点，说明无路径
                 auto it = prev.find(temp);
                 if (it == prev.end()) {
                     throw std::runtime_error("No BFS path found from start to end!");
                 }
                 temp = it->second;
             }
-            std::reverse(path.begin(), path.end()); // ת·յ
+            std::reverse(path.begin(), path.end()); // 反转路径：起点→终点
             return path;
         }
 
-        // ĸ
+        stats.onExpand();
+
+        // 遍历四个方向
         for (const auto& dir : dirs) {
             int newRow = cur.row + dir[0];
             int newCol = cur.col + dir[1];
             Point newPos = { newRow, newCol };
 
-            // ؿϷδʣ
+            // 若地块合法且未访问，加入队列
             if (isLegal(newRow, newCol) && !visited[newRow][newCol]) {
                 visited[newRow][newCol] = true;
-                prev[newPos] = cur; // ¼ǰڵ
+                prev[newPos] = cur; // 记录前驱节点
                 q.push(newPos);
+                stats.onPush(q.size());
             }
         }
     }
 
-    // пδҵյ㣬׳쳣
+    // 若队列空仍未找到终点，抛出异常
+    if (Stats::ENABLED) stats.finish(mapBytes(prev) + visitedBytes(visited), sizeof(Point));
     throw std::runtime_error("No BFS path found from start to end!");
 }
 
-// 3. DijkstraҳȨ·ǵؿɱ
-std::vector<Point> PathFinder::findShortestPathByDijkstra() {
-    // ӳ䣺Point  㵽õ̾
+// 3. 基础任务：Dijkstra找出加权最短路径（考虑地块成本）
+template<typename Stats>
+std::vector<Point> PathFinder::dijkstraSearch(Stats& stats, const Point& start, const Point& goal) {
+    // 距离映射：Point → 从起点到该点的最短距离
     std::unordered_map<Point, int> dist;
-    // ǰӳ䣺Point  ǰڵ㣨ڻ·
+    // 前驱映射：Point → 前驱节点（用于回溯路径）
     std::unordered_map<Point, Point> prev;
-    // ȶУСѣУ洢룬꣩
+    // 优先队列（小根堆）：按距离升序排列，存储（距离，坐标）
     using PQElement = std::pair<int, Point>;
     std::priority_queue<PQElement, std::vector<PQElement>, std::greater<>> pq;
 
-    // ʼ0
-    dist[startPoint] = 0;
-    pq.push({ 0, startPoint });
+    // 起点初始化：距离0，加入队列
+    dist[start] = 0;
+    pq.push({ 0, start });
+    stats.onPush(pq.size());
 
     while (!pq.empty()) {
         auto top = pq.top();
@@ -167,41 +321,47 @@ std::vector<Point> PathFinder::findShortestPathByDijkstra() {
         int curDist = top.first;
         Point curPos = top.second;
 
-        // ֹյ㣬ǰ˳ȶб֤ʱΪ̾룩
-        if (curPos == endPoint) break;
+        // 终止条件：到达终点，提前退出（优先队列保证此时为最短距离）
+        if (curPos == goal) break;
 
-        // ǰ֪̾룬ڵ㣩
-        if (curDist > dist[curPos]) continue;
+        // 若当前距离大于已知最短距离，跳过（冗余节点）
+        if (curDist > dist[curPos]) {
+            stats.onStalePop();
+            continue;
+        }
+        stats.onExpand();
 
-        // ĸ
+        // 遍历四个方向
         for (const auto& dir : dirs) {
             int newRow = curPos.row + dir[0];
             int newCol = curPos.col + dir[1];
             Point newPos = { newRow, newCol };
 
-            // Ƿؿ
+            // 跳过非法地块
             if (!isLegal(newRow, newCol)) continue;
 
-            // ¾룺ǰ + µؿɱ
+            // 计算新距离：当前距离 + 新地块成本
             int newDist = curDist + getCost(newRow, newCol);
 
-            // ¾̣¾ǰ
+            // 若新距离更短，更新距离和前驱，并加入队列
             if (dist.find(newPos) == dist.end() || newDist < dist[newPos]) {
                 dist[newPos] = newDist;
                 prev[newPos] = curPos;
                 pq.push({ newDist, newPos });
+                stats.onPush(pq.size());
             }
         }
     }
+    if (Stats::ENABLED) stats.finish(mapBytes(dist) + mapBytes(prev), sizeof(PQElement));
 
-    // ·յ㵽
+    // 回溯路径：从终点到起点
     std::vector<Point> path;
-    Point cur = endPoint;
+    Point cur = goal;
     while (true) {
         path.push_back(cur);
-        if (cur == startPoint) break;
+        if (cur == start) break;
 
-        // ǰڵ㣬˵·
+        // 若无前驱节点，说明无路径
         auto it = prev.find(cur);
         if (it == prev.end()) {
             throw std::runtime_error("No Dijkstra path found from start to end!");
@@ -209,23 +369,25 @@ std::vector<Point> PathFinder::findShortestPathByDijkstra() {
         cur = it->second;
     }
 
-    std::reverse(path.begin(), path.end()); // ת·յ
+    std::reverse(path.begin(), path.end()); // 反转路径：起点→终点
     return path;
 }
 
-// 4. 1ҵ·ҲƳɱ
-std::vector<Point> PathFinder::findShortestPathWithOneLava() {
-    // ӳ䣺(, ǷѲȹ)  ̾
+// 4. 进阶任务：允许踩1次熔岩的最短路径（熔岩不计成本）
+template<typename Stats>
+std::vector<Point> PathFinder::oneLavaSearch(Stats& stats, const Point& start, const Point& goal) {
+    // 距离映射：(坐标, 是否已踩过熔岩) → 最短距离
     std::unordered_map<std::pair<Point, bool>, int> dist;
-    // ǰӳ䣺(, ǷѲȹ)  (ǰ, ǰǷѲȹ)
+    // 前驱映射：(坐标, 是否已踩过熔岩) → (前驱坐标, 前驱是否已踩过熔岩)
     std::unordered_map<std::pair<Point, bool>, std::pair<Point, bool>> prev;
-    // ȶУСѣ洢DijkstraNodeǷȹң
+    // 优先队列（小根堆）：存储DijkstraNode（包含是否踩过熔岩）
     std::priority_queue<DijkstraNode, std::vector<DijkstraNode>, std::greater<>> pq;
 
-    // ʼδȹң0
-    auto startKey = std::make_pair(startPoint, false);
+    // 起点初始化：未踩过熔岩，距离0
+    auto startKey = std::make_pair(start, false);
     dist[startKey] = 0;
-    pq.push({ startPoint, 0, false });
+    pq.push({ start, 0, false });
+    stats.onPush(pq.size());
 
     while (!pq.empty()) {
         auto curNode = pq.top();
@@ -234,17 +396,18 @@ std::vector<Point> PathFinder::findShortestPathWithOneLava() {
         int curDist = curNode.dist;
         bool curHasLava = curNode.hasSteppedLava;
 
-        // ֹյ㣬·
-        if (curPos == endPoint) {
+        // 终止条件：到达终点，回溯路径
+        if (curPos == goal) {
+            if (Stats::ENABLED) stats.finish(mapBytes(dist) + mapBytes(prev), sizeof(DijkstraNode));
             std::vector<Point> path;
             auto curKey = std::make_pair(curPos, curHasLava);
 
             while (true) {
                 path.push_back(curKey.first);
-                // ֹݵ㣨δȹң
-                if (curKey.first == startPoint && !curKey.second) break;
+                // 终止：回溯到起点（未踩过熔岩）
+                if (curKey.first == start && !curKey.second) break;
 
-                // ǰڵ㣬˵·
+                // 若无前驱节点，说明无路径
                 auto it = prev.find(curKey);
                 if (it == prev.end()) {
                     throw std::runtime_error("No lava-once path found from start to end!");
@@ -252,48 +415,54 @@ std::vector<Point> PathFinder::findShortestPathWithOneLava() {
                 curKey = it->second;
             }
 
-            std::reverse(path.begin(), path.end()); // ת·յ
+            std::reverse(path.begin(), path.end()); // 反转路径：起点→终点
             return path;
         }
 
-        // ǰ֪̾룬ڵ㣩
+        // 若当前距离大于已知最短距离，跳过（冗余节点）
         auto curKey = std::make_pair(curPos, curHasLava);
-        if (curDist > dist[curKey]) continue;
+        if (curDist > dist[curKey]) {
+            stats.onStalePop();
+            continue;
+        }
+        stats.onExpand();
 
-        // ĸ
+        // 遍历四个方向
         for (const auto& dir : dirs) {
             int newRow = curPos.row + dir[0];
             int newCol = curPos.col + dir[1];
             Point newPos = { newRow, newCol };
 
-            // Ƿؿ飨ǽ
+            // 跳过非法地块（墙）
             if (!isLegal(newRow, newCol)) continue;
 
             BlockType newBlock = maze.mapData[newRow][newCol];
             bool newHasLava = curHasLava;
 
-            // ҵؿ飺δȹǣѲȹ
+            // 处理熔岩地块：未踩过则标记，已踩过则跳过
             if (newBlock == BlockType::LAVA) {
-                if (curHasLava) continue; // Ѳȹ1Σٲ
-                newHasLava = true;        // ״βң״̬
+                if (curHasLava) continue; // 已踩过1次，不能再踩
+                newHasLava = true;        // 首次踩熔岩，标记状态
             }
 
-            // ¾룺ҲƳɱҪ󣩣ؿ鰴ԭɱ
+            // 计算新距离：熔岩不计成本（任务要求），其他地块按原成本
             int cost = (newBlock == BlockType::LAVA) ? 0 : getCost(newRow, newCol);
             int newDist = curDist + cost;
 
-            // ״̬(, ״̬)
+            // 新状态键：(新坐标, 新熔岩状态)
             auto newKey = std::make_pair(newPos, newHasLava);
 
-            // ¾̣¾ǰ
+            // 若新距离更短，更新距离和前驱，并加入队列
             if (dist.find(newKey) == dist.end() || newDist < dist[newKey]) {
                 dist[newKey] = newDist;
                 prev[newKey] = curKey;
                 pq.push({ newPos, newDist, newHasLava });
+                stats.onPush(pq.size());
             }
         }
     }
 
-    // пδҵյ㣬׳쳣
+    // 若队列空仍未找到终点，抛出异常
+    if (Stats::ENABLED) stats.finish(mapBytes(dist) + mapBytes(prev), sizeof(DijkstraNode));
     throw std::runtime_error("No lava-once path found from start to end!");
 }
\ No newline at end of file
@@ -7,25 +7,27 @@
 #include <climits>
 #include <functional>
 #include <utility>
+#include <atomic>
+#include <stdexcept>
 
-// ṹ壨ݽṹ·ʾ
+// 坐标结构体（基础数据结构，用于路径表示）
 struct Point {
     int row;
     int col;
 
-    // ==жǷ
+    // 重载==：用于判断坐标是否相等
     bool operator==(const Point& other) const {
         return row == other.row && col == other.col;
     }
 
-    // <ȶDijkstra㷨
+    // 重载<：用于优先队列排序（Dijkstra算法）
     bool operator<(const Point& other) const {
         if (row != other.row) return row < other.row;
         return col < other.col;
     }
 };
 
-// ΪPointʵֹϣunordered_mapļ
+// 为Point实现哈希（用于unordered_map的键）
 namespace std {
     template<> struct hash<Point> {
         size_t operator()(const Point& p) const {
@@ -33,7 +35,7 @@ namespace std {
         }
     };
 
-    // Ϊpair<Point, bool>ʵֹϣ1·㷨
+    // 为pair<Point, bool>实现哈希（用于熔岩1次路径算法）
     template<> struct hash<std::pair<Point, bool>> {
         size_t operator()(const std::pair<Point, bool>& p) const {
             auto h1 = hash<Point>{}(p.first);
@@ -43,53 +45,101 @@ namespace std {
     };
 }
 
-// ·ࣨDFS/BFS/Dijkstra1·
+// 单次搜索的统计（带SearchStats&参数的搜索接口填写；不带参数的接口不做任何统计，无额外开销）
+struct SearchStats {
+    long long nodesExpanded = 0;  // 扩展（出队并遍历邻居）的节点数；DFS为递归访问的节点数
+    long long nodesPushed = 0;    // 入队次数；DFS为压入当前路径的次数
+    long long stalePops = 0;      // 出队时距离已过期被跳过的次数（Dijkstra/熔岩路径）
+    size_t peakFrontier = 0;      // 队列/堆的峰值长度；DFS为最大递归深度
+    size_t bytesAllocated = 0;    // 搜索用容器的堆占用（按容器规模估算）
+    double wallMs = 0.0;          // 墙钟耗时（毫秒）
+};
+
+// 点对点查询可选的搜索算法
+enum class SearchAlgorithm {
+    BFS,        // 步数最少
+    DIJKSTRA,   // 地块成本最小
+    LAVA_ONCE   // 允许踩1次熔岩（熔岩不计成本）
+};
+
+// 搜索因取消标志被置位而中止时抛出
+class SearchCancelled : public std::runtime_error {
+public:
+    SearchCancelled() : std::runtime_error("Path search cancelled") {}
+};
+
+// 路径查找类（基础任务：DFS/BFS/Dijkstra；进阶任务：熔岩1次路径）
 class PathFinder {
 public:
-    // 죺Թʼյ
+    // 构造：传入迷宫，初始化起点和终点
     PathFinder(const Maze& maze);
 
-    // 1. DFSҳпɴ·صһ·ڻƣ
-    std::vector<std::vector<Point>> findAllPathsByDFS();
+    // 1. 基础任务：DFS找出所有可达路径（返回第一条路径用于绘制）
+    //    maxPaths > 0 时找到该数量的路径即停止（路径数随迷宫规模指数增长，大迷宫需设上限）
+    std::vector<std::vector<Point>> findAllPathsByDFS(size_t maxPaths = 0);
+    std::vector<std::vector<Point>> findAllPathsByDFS(SearchStats& stats, size_t maxPaths = 0);
 
-    // 2. BFSҳ·Ȩͼ·
+    // 2. 基础任务：BFS找出最短路径（无权图最短路径）
     std::vector<Point> findShortestPathByBFS();
+    std::vector<Point> findShortestPathByBFS(SearchStats& stats);
 
-    // 3. DijkstraҳȨ·ǵؿɱ
+    // 3. 基础任务：Dijkstra找出加权最短路径（考虑地块成本）
     std::vector<Point> findShortestPathByDijkstra();
+    std::vector<Point> findShortestPathByDijkstra(SearchStats& stats);
 
-    // 4. 1ҵ·ҲƳɱ
+    // 4. 进阶任务：允许踩1次熔岩的最短路径（熔岩不计成本）
     std::vector<Point> findShortestPathWithOneLava();
+    std::vector<Point> findShortestPathWithOneLava(SearchStats& stats);
+
+    // 5. 任意起终点的查询（异步寻路服务等使用；无路径时抛runtime_error）
+    //    cancelFlag非空时，搜索过程中定期检查，变为true则抛出SearchCancelled
+    //    各搜索只读迷宫、使用局部容器，可在多个线程上同时调用
+    std::vector<Point> findPath(SearchAlgorithm algorithm, const Point& start, const Point& goal,
+        const std::atomic<bool>* cancelFlag = nullptr);
+
+    // 进入某类地块的移动成本（墙为INT_MAX）
+    static int tileCost(BlockType type);
+
+    // 起点/终点坐标（构造时查找）
+    const Point& getStartPoint() const { return startPoint; }
+    const Point& getEndPoint() const { return endPoint; }
 
 private:
-    // ṹ壺Dijkstraڵ㣨ǷѲȹңã
+    // 辅助结构体：Dijkstra节点（包含是否已踩过熔岩，进阶任务用）
     struct DijkstraNode {
         Point pos;
         int dist;
         bool hasSteppedLava;
 
-        // ȶ򣨾Сȣͬδҵȣ
+        // 优先队列排序规则（距离小的优先，相同距离则未踩熔岩的优先）
         bool operator>(const DijkstraNode& other) const {
             if (dist != other.dist) return dist > other.dist;
             return hasSteppedLava > other.hasSteppedLava;
         }
     };
 
-    // DFSݹ鸨񣺱·
+    // 各搜索的实现，Stats为统计策略（空策略的计数调用在编译期被内联消除）
+    template<typename Stats> std::vector<std::vector<Point>> dfsSearch(Stats& stats, size_t maxPaths);
+    template<typename Stats> std::vector<Point> bfsSearch(Stats& stats, const Point& start, const Point& goal);
+    template<typename Stats> std::vector<Point> dijkstraSearch(Stats& stats, const Point& start, const Point& goal);
+    template<typename Stats> std::vector<Point> oneLavaSearch(Stats& stats, const Point& start, const Point& goal);
+
+    // DFS递归辅助函数（基础任务：遍历所有路径）
+    template<typename Stats>
     void dfsHelper(int row, int col, std::vector<Point>& curPath,
         std::vector<std::vector<bool>>& visited,
-        std::vector<std::vector<Point>>& allPaths);
+        std::vector<std::vector<Point>>& allPaths, size_t maxPaths, Stats& stats);
 
-    // ϷԼ飺ǷԹΧҷǽͨø
+    // 合法性检查：坐标是否在迷宫范围内且非墙（通用辅助方法）
     bool isLegal(int row, int col) const;
 
-    // ɱ㣺ݵؿͷƶɱDijkstra㷨ã
+    // 成本计算：根据地块类型返回移动成本（基础任务：Dijkstra算法用）
     int getCost(int row, int col) const;
 
-    const Maze& maze;          // Թݣֻ޸ģ
-    Point startPoint;          // ꣨ʼʱң
-    Point endPoint;            // յ꣨ʼʱң
-    const int dirs[4][2] = {   // ĸƶң
+    const Maze& maze;          // 迷宫数据（只读，避免修改）
+    Point startPoint;          // 起点坐标（初始化时查找）
+    Point endPoint;            // 终点坐标（初始化时查找）
+    const int dirs[4][2] = {   // 四个移动方向（上下左右）
         {-1,0}, {1,0}, {0,-1}, {0,1}
     };
 };
@@ -0,0 +1,252 @@
+#include "PathQueryEngine.h"
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <string>
+
+namespace {
+    const int DIRS[4][2] = { {-1,0}, {1,0}, {0,-1}, {0,1} };
+}
+
+// 构造：网格 → 连通分量 → 起点/终点的BFS、Dijkstra最短路树 → 各成本模型的地标
+PathQueryEngine::PathQueryEngine(const Maze& maze, int landmarkCount)
+    : grid(maze, CellGrid::preferredLayout(maze)), componentCount(0), buildMs(0.0) {
+    auto begin = std::chrono::steady_clock::now();
+    PathFinder probe(maze); // 缺少起终点时在此抛出
+    startPoint = probe.getStartPoint();
+    endPoint = probe.getEndPoint();
+    labelComponents();
+    const SearchAlgorithm algorithms[2] = { SearchAlgorithm::BFS, SearchAlgorithm::DIJKSTRA };
+    for (int i = 0; i < 2; ++i) {
+        buildTree(fromStart[i], algorithms[i], startPoint, false);
+        buildTree(toEnd[i], algorithms[i], endPoint, true);
+    }
+    if (landmarkCount > 0) {
+        const SearchAlgorithm models[3] = { SearchAlgorithm::BFS, SearchAlgorithm::DIJKSTRA, SearchAlgorithm::LAVA_ONCE };
+        for (int i = 0; i < 3; ++i) oracles[i].build(grid, models[i], startPoint, landmarkCount);
+    }
+    buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+void PathQueryEngine::labelComponents() {
+    componentLabels.assign(grid.getCellCount(), -1);
+    std::vector<int> stack;
+    for (int row = 0; row < grid.getRows(); ++row) {
+        for (int col = 0; col < grid.getCols(); ++col) {
+            int seed = grid.index(row, col);
+            if (componentLabels[seed] != -1 || grid.at(seed) == BlockType::WALL) continue;
+            componentLabels[seed] = componentCount;
+            stack.push_back(seed);
+            while (!stack.empty()) {
+                int cell = stack.back();
+                stack.pop_back();
+                Point p = grid.position(cell);
+                for (int d = 0; d < 4; ++d) {
+                    int next = grid.neighbor(cell, p.row, p.col, d);
+                    if (next < 0 || componentLabels[next] != -1 || grid.at(next) == BlockType::WALL) continue;
+                    componentLabels[next] = componentCount;
+                    stack.push_back(next);
+                }
+            }
+            ++componentCount;
+        }
+    }
+}
+
+// 单源最短路树（BFS为单位成本，同样用堆实现即可；只在加载时运行一次）。
+// toAnchor时反向松弛：从u走到邻格v的反向边v→u，成本是进入u的成本
+void PathQueryEngine::buildTree(AnchorTree& tree, SearchAlgorithm algorithm, const Point& anchor, bool toAnchor) {
+    tree.dist.assign(grid.getCellCount(), INT_MAX);
+    tree.link.assign(grid.getCellCount(), -1);
+    typedef std::pair<int, int> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    const int root = grid.index(anchor.row, anchor.col);
+    tree.dist[root] = 0;
+    heap.push({ 0, root });
+    while (!heap.empty()) {
+        Entry top = heap.top();
+        heap.pop();
+        const int cell = top.second;
+        if (top.first > tree.dist[cell]) continue;
+        const Point p = grid.position(cell);
+        const int leaveCost = stepCost(algorithm, grid.at(cell));
+        for (int d = 0; d < 4; ++d) {
+            int next = grid.neighbor(cell, p.row, p.col, d);
+            if (next < 0) continue;
+            BlockType block = grid.at(next);
+            if (block == BlockType::WALL) continue;
+            int newDist = top.first + (toAnchor ? leaveCost : stepCost(algorithm, block));
+            if (newDist < tree.dist[next]) {
+                tree.dist[next] = newDist;
+                tree.link[next] = cell;
+                heap.push({ newDist, next });
+            }
+        }
+    }
+}
+
+bool PathQueryEngine::walkTree(const AnchorTree& tree, bool toAnchor, const Point& from, PathQueryResult& result) const {
+    int cell = grid.index(from.row, from.col);
+    if (tree.dist[cell] == INT_MAX) return false;
+    result.cost = tree.dist[cell];
+    for (int cur = cell; cur != -1; cur = tree.link[cur]) {
+        result.path.push_back(grid.position(cur));
+    }
+    // 从起点出发的树回溯得到的是goal→START，需要反转；到终点的树本身就是正向
+    if (!toAnchor) std::reverse(result.path.begin(), result.path.end());
+    return true;
+}
+
+void PathQueryEngine::checkQuery(SearchAlgorithm algorithm, const Point& start, const Point& goal, int lavaBudget) const {
+    auto legal = [this](const Point& p) {
+        return p.row >= 0 && p.row < grid.getRows() && p.col >= 0 && p.col < grid.getCols()
+            && grid.at(grid.index(p.row, p.col)) != BlockType::WALL;
+    };
+    if (!legal(start) || !legal(goal)) {
+        throw std::runtime_error("Path query endpoint is outside the maze or inside a wall");
+    }
+    if (algorithm == SearchAlgorithm::LAVA_ONCE && (lavaBudget < 0 || lavaBudget > MAX_LAVA_BUDGET)) {
+        throw std::runtime_error("Lava budget must be between 0 and " + std::to_string(MAX_LAVA_BUDGET));
+    }
+}
+
+void PathQueryEngine::solve(Scratch& scratch, SearchAlgorithm algorithm, const Point& start, const Point& goal,
+    int lavaBudget, PathQueryResult& result) const {
+    checkQuery(algorithm, start, goal, lavaBudget);
+    result.found = false;
+    result.cost = 0;
+    result.lavaSteps = 0;
+    result.path.clear();
+    result.expanded = 0;
+
+    if (componentLabels[grid.index(start.row, start.col)] != componentLabels[grid.index(goal.row, goal.col)]) return;
+
+    if (algorithm != SearchAlgorithm::LAVA_ONCE) {
+        const int tree = algorithm == SearchAlgorithm::BFS ? 0 : 1;
+        if (start == startPoint) result.found = walkTree(fromStart[tree], false, goal, result);
+        else if (goal == endPoint) result.found = walkTree(toEnd[tree], true, start, result);
+        else search(scratch, algorithm, start, goal, 0, result);
+    }
+    else {
+        search(scratch, algorithm, start, goal, lavaBudget, result);
+    }
+    if (result.found) {
+        for (size_t i = 1; i < result.path.size(); ++i) {
+            if (grid.at(grid.index(result.path[i].row, result.path[i].col)) == BlockType::LAVA) ++result.lavaSteps;
+        }
+    }
+}
+
+bool PathQueryEngine::bounds(SearchAlgorithm algorithm, const Point& start, const Point& goal, DistanceBounds& result) const {
+    checkQuery(algorithm, start, goal, 0);
+    const int from = grid.index(start.row, start.col), to = grid.index(goal.row, goal.col);
+    if (componentLabels[from] != componentLabels[to]) return false;
+    if (algorithm != SearchAlgorithm::LAVA_ONCE && (start == startPoint || goal == endPoint)) {
+        const int tree = algorithm == SearchAlgorithm::BFS ? 0 : 1;
+        result.known = true;
+        result.lower = result.upper = start == startPoint ? fromStart[tree].dist[to] : toEnd[tree].dist[from];
+        return true;
+    }
+    const LandmarkOracle& oracle = getOracle(algorithm);
+    result = oracle.bounds(from, to);
+    // 起点所在分量以外没有地标；步数至少为曼哈顿距离（熔岩预算查询不计熔岩，没有这条下界）
+    const int manhattan = std::abs(start.row - goal.row) + std::abs(start.col - goal.col);
+    if (!result.known) {
+        result.known = true;
+        result.lower = 0;
+        result.upper = INT_MAX;
+    }
+    if (algorithm != SearchAlgorithm::LAVA_ONCE) result.lower = std::max(result.lower, manhattan);
+    else result.upper = INT_MAX; // 松弛模型的绕行路线可能超出熔岩预算，不能作为上界
+    return true;
+}
+
+void PathQueryEngine::Scratch::prepare(size_t states) {
+    if (++epoch == 0) {
+        std::fill(stamp.begin(), stamp.end(), 0u);
+        epoch = 1;
+    }
+    if (stamp.size() < states) {
+        stamp.resize(states, 0u);
+        dist.resize(states);
+        prev.resize(states);
+    }
+    heap.clear();
+}
+
+// A*：状态 = 网格序号 * layers + 已踩熔岩数（非熔岩预算查询layers为1）。
+// 下界：BFS/Dijkstra每步成本至少1，取曼哈顿距离；熔岩预算查询中剩余的预算格可以免费走，
+// 取max(0, 曼哈顿距离 - 剩余预算)（进入熔岩时距离和预算各减1，下界仍单调）；
+// 建有地标时再与地标下界取较大者。地标距离量化后下界可能不一致，因此更短的成本到达已出堆的状态时照常重新入堆，
+// 下界可采纳即可保证终点出堆时最优
+void PathQueryEngine::search(Scratch& scratch, SearchAlgorithm algorithm, const Point& start, const Point& goal,
+    int lavaBudget, PathQueryResult& result) const {
+    const bool lavaMode = algorithm == SearchAlgorithm::LAVA_ONCE;
+    const int layers = lavaMode ? lavaBudget + 1 : 1;
+    scratch.prepare(grid.getCellCount() * layers);
+    const LandmarkOracle& oracle = getOracle(algorithm);
+    const int goalCell = grid.index(goal.row, goal.col);
+    if (oracle.isBuilt()) oracle.prepareTarget(goalCell, scratch.target);
+    else scratch.target.covered = false;
+    auto bound = [&](int cell, int row, int col, int used) {
+        int manhattan = std::abs(row - goal.row) + std::abs(col - goal.col);
+        int h = lavaMode ? std::max(0, manhattan - (lavaBudget - used)) : manhattan;
+        return scratch.target.covered ? std::max(h, oracle.lowerBound(cell, scratch.target)) : h;
+    };
+
+    std::vector<Scratch::HeapEntry>& heap = scratch.heap;
+    const int startCell = grid.index(start.row, start.col);
+    const int startState = startCell * layers;
+    scratch.stamp[startState] = scratch.epoch;
+    scratch.dist[startState] = 0;
+    scratch.prev[startState] = -1;
+    heap.push_back({ bound(startCell, start.row, start.col, 0), 0, startState });
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<Scratch::HeapEntry>());
+        const Scratch::HeapEntry top = heap.back();
+        heap.pop_back();
+        if (top.g > scratch.dist[top.state]) continue; // 过期条目
+
+        const int state = top.state;
+        const int cell = state / layers;
+        const int used = state % layers;
+        ++result.expanded;
+        if (cell == goalCell) {
+            result.found = true;
+            result.cost = top.g;
+            for (int cur = state; cur != -1; cur = scratch.prev[cur]) {
+                result.path.push_back(grid.position(cur / layers));
+            }
+            std::reverse(result.path.begin(), result.path.end());
+            return;
+        }
+
+        const Point p = grid.position(cell);
+        for (int d = 0; d < 4; ++d) {
+            int next = grid.neighbor(cell, p.row, p.col, d);
+            if (next < 0) continue;
+            BlockType block = grid.at(next);
+            if (block == BlockType::WALL) continue;
+            int nextUsed = used, cost;
+            if (lavaMode && block == BlockType::LAVA) {
+                if (used == lavaBudget) continue;
+                ++nextUsed;
+                cost = 0;
+            }
+            else {
+                cost = stepCost(algorithm, block);
+            }
+            const int nextState = next * layers + nextUsed;
+            const int g = top.g + cost;
+            if (scratch.seen(nextState) && g >= scratch.dist[nextState]) continue;
+            scratch.stamp[nextState] = scratch.epoch;
+            scratch.dist[nextState] = g;
+            scratch.prev[nextState] = state;
+            heap.push_back({ g + bound(next, p.row + DIRS[d][0], p.col + DIRS[d][1], nextUsed), g, nextState });
+            std::push_heap(heap.begin(), heap.end(), std::greater<Scratch::HeapEntry>());
+        }
+    }
+}
@@ -0,0 +1,118 @@
+#ifndef PATH_QUERY_ENGINE_H
+#define PATH_QUERY_ENGINE_H
+#include "PathFinder.h"
+#include "CellGrid.h"
+#include "LandmarkOracle.h"
+#include <vector>
+#include <cstdint>
+
+// 一次点对点查询的结果
+struct PathQueryResult {
+    bool found = false;
+    int cost = 0;                  // 按算法计的路径成本（BFS为步数）
+    int lavaSteps = 0;             // 路径踩到的熔岩格数
+    std::vector<Point> path;       // 起点到终点（含两端）；无路径时为空
+    long long expanded = 0;        // 扩展节点数（0表示直接由常驻的最短路树给出）
+};
+
+// 常驻寻路引擎（查询服务使用）：一张迷宫加载一次，预先建好地块网格、连通分量，
+// 以及以起点/终点为根的BFS与Dijkstra最短路树；之后的查询只读这些数据，可在多个线程上并发。
+// - 不同连通分量之间的查询直接判无路；
+// - 起点是迷宫START或终点是迷宫END的BFS/Dijkstra查询沿最短路树回溯，耗时只与路径长度成正比；
+// - 其余查询用A*，下界取曼哈顿距离与地标（ALT）三角不等式下界中的较大者；
+//   搜索状态放在调用方每线程一份的Scratch中，用代号标记复用，不必每次清空
+// - bounds不经搜索给出距离区间（最短路树覆盖的查询给出精确值）
+// 成本模型与PathFinder一致；熔岩预算查询是LAVA_ONCE的推广：踩熔岩不计成本，但至多踩lavaBudget格
+class PathQueryEngine {
+public:
+    static const int MAX_LAVA_BUDGET = 4;
+    static const int DEFAULT_LANDMARKS = 8;
+
+    // 迷宫缺少起点或终点时抛出runtime_error。landmarkCount为每种成本模型的地标数（在起点所在分量内选取），0表示不建地标
+    explicit PathQueryEngine(const Maze& maze, int landmarkCount = DEFAULT_LANDMARKS);
+
+    PathQueryEngine(const PathQueryEngine&) = delete;
+    PathQueryEngine& operator=(const PathQueryEngine&) = delete;
+
+    // 每个查询线程一份的搜索状态（首次使用时按迷宫规模分配，之后复用）
+    class Scratch {
+    public:
+        Scratch() : epoch(0) {}
+
+    private:
+        friend class PathQueryEngine;
+        struct HeapEntry {
+            int f;       // 成本 + 下界
+            int g;       // 成本（f相同时优先扩展成本大的，即离终点近的）
+            int state;
+            bool operator>(const HeapEntry& other) const {
+                return f != other.f ? f > other.f : g < other.g;
+            }
+        };
+        // 开始一次新搜索：代号加一（回绕时清空标记），数组不足时扩容
+        void prepare(size_t states);
+        bool seen(int state) const { return stamp[state] == epoch; }
+
+        std::vector<uint32_t> stamp;  // 状态的代号等于epoch时dist/prev有效
+        std::vector<int> dist;
+        std::vector<int> prev;
+        std::vector<HeapEntry> heap;
+        LandmarkOracle::Target target;  // 本次查询终点的地标距离
+        uint32_t epoch;
+    };
+
+    // 查询start到goal的路径，写入result（复用其path的容量）。
+    // 起终点越界或为墙、熔岩预算超出[0, MAX_LAVA_BUDGET]时抛出runtime_error；无路径时result.found为false
+    void solve(Scratch& scratch, SearchAlgorithm algorithm, const Point& start, const Point& goal,
+        int lavaBudget, PathQueryResult& result) const;
+
+    // 不经搜索的成本区间（端点检查同solve）。不同连通分量时返回false；
+    // 熔岩预算查询只有下界（upper为INT_MAX）；起点是START或终点是END的BFS/Dijkstra查询给出精确值
+    bool bounds(SearchAlgorithm algorithm, const Point& start, const Point& goal, DistanceBounds& result) const;
+
+    // 端点越界或为墙、熔岩预算超出范围时抛出runtime_error（solve/bounds使用的同一检查，供基于本引擎的其他查询复用）
+    void checkQuery(SearchAlgorithm algorithm, const Point& start, const Point& goal, int lavaBudget) const;
+    // 两格在同一连通分量（不检查端点）
+    bool isConnected(const Point& a, const Point& b) const {
+        return componentLabels[grid.index(a.row, a.col)] == componentLabels[grid.index(b.row, b.col)];
+    }
+
+    const CellGrid& getGrid() const { return grid; }
+    // 按算法的地标预言机（未建时isBuilt为false）
+    const LandmarkOracle& getOracle(SearchAlgorithm algorithm) const { return oracles[static_cast<int>(algorithm)]; }
+    const Point& getStartPoint() const { return startPoint; }
+    const Point& getEndPoint() const { return endPoint; }
+    int getComponentCount() const { return componentCount; }
+    // 预处理（网格、分量、最短路树、地标）耗时（毫秒）
+    double getBuildMs() const { return buildMs; }
+
+private:
+    // 以anchor为根的最短路树：toAnchor为false时dist是anchor到各格的成本，link指向前驱（朝anchor方向）；
+    // 为true时dist是各格到anchor的成本（“进入格子才计成本”不对称，需反向松弛），link指向下一格
+    struct AnchorTree {
+        std::vector<int> dist;
+        std::vector<int> link;
+    };
+    void buildTree(AnchorTree& tree, SearchAlgorithm algorithm, const Point& anchor, bool toAnchor);
+    void labelComponents();
+    // 沿最短路树回溯出路径；成功时返回true
+    bool walkTree(const AnchorTree& tree, bool toAnchor, const Point& from, PathQueryResult& result) const;
+    // A*搜索
+    void search(Scratch& scratch, SearchAlgorithm algorithm, const Point& start, const Point& goal,
+        int lavaBudget, PathQueryResult& result) const;
+    int stepCost(SearchAlgorithm algorithm, BlockType block) const {
+        return algorithm == SearchAlgorithm::BFS ? 1 : PathFinder::tileCost(block);
+    }
+
+    CellGrid grid;
+    Point startPoint;
+    Point endPoint;
+    std::vector<int> componentLabels;  // 按网格序号；墙为-1
+    int componentCount;
+    AnchorTree fromStart[2];           // [0]为BFS，[1]为Dijkstra
+    AnchorTree toEnd[2];
+    LandmarkOracle oracles[3];         // 按SearchAlgorithm：BFS、Dijkstra、熔岩不计成本的松弛
+    double buildMs;
+};
+
+#endif // PATH_QUERY_ENGINE_H
@@ -0,0 +1,145 @@
+#include "PathService.h"
+#include <chrono>
+
+// 构造：启动工作线程（每个线程使用自己的PathFinder；workerCount为0时为分帧模式）
+PathService::PathService(const Maze& maze, int workerCount)
+    : maze(maze), stopping(false), completedCount(0), cancelledCount(0) {
+    PathFinder probe(maze); // 迷宫缺少起终点时在此抛出，而不是在工作线程中
+    (void)probe;
+    for (int i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&PathService::workerLoop, this);
+    }
+}
+
+// 析构：取消所有未完成查询（计入getCancelledCount）并等待工作线程退出
+PathService::~PathService() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+        for (auto& request : queue) {
+            publish(*request, PathRequest::Status::CANCELLED);
+        }
+        queue.clear();
+    }
+    for (auto& entry : latest) {
+        entry.second->cancelFlag.store(true, std::memory_order_relaxed);
+    }
+    if (slicedRequest) {
+        publish(*slicedRequest, PathRequest::Status::CANCELLED);
+    }
+    queueReady.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+PathHandle PathService::request(int agent, const Point& start, const Point& goal, SearchAlgorithm algorithm) {
+    // 取代旧查询时沿用该agent在latest中的节点（先cancel再插入会每次释放、重新分配一个哈希表节点）
+    std::shared_ptr<PathRequest>& slot = latest[agent];
+    if (slot) slot->cancelFlag.store(true, std::memory_order_relaxed);
+    std::shared_ptr<PathRequest> request(new PathRequest(agent, start, goal, algorithm));
+    slot = request;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue.push_back(request);
+    }
+    if (!workers.empty()) queueReady.notify_one();
+    return request;
+}
+
+void PathService::cancel(int agent) {
+    auto it = latest.find(agent);
+    if (it == latest.end()) return;
+    it->second->cancelFlag.store(true, std::memory_order_relaxed);
+    latest.erase(it);
+}
+
+// 分帧模式：当前查询用ResumableSearch推进，完成后取下一个，直到预算用完
+void PathService::pump(double budgetMicroseconds) {
+    if (!workers.empty()) return;
+    auto begin = std::chrono::steady_clock::now();
+    double remaining = budgetMicroseconds;
+    while (remaining > 0.0) {
+        if (!slicedRequest) {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (queue.empty()) return;
+            slicedRequest = queue.front();
+            queue.pop_front();
+        }
+
+        PathRequest& request = *slicedRequest;
+        if (request.cancelFlag.load(std::memory_order_relaxed)) {
+            publish(request, PathRequest::Status::CANCELLED);
+        }
+        else {
+            auto sliceBegin = std::chrono::steady_clock::now();
+            ResumableSearch::Status status = ResumableSearch::Status::NO_PATH;
+            try {
+                if (!slicedSearch) {
+                    request.status.store(PathRequest::Status::RUNNING, std::memory_order_relaxed);
+                    // 地块网格在首个分帧查询时建立，之后各查询共享
+                    if (!slicedGrid) slicedGrid = std::make_shared<const CellGrid>(maze, CellGrid::preferredLayout(maze));
+                    slicedSearch.reset(new ResumableSearch(slicedGrid, request.algorithm, request.start, request.goal));
+                }
+                status = slicedSearch->step(remaining);
+            }
+            catch (const std::runtime_error&) {
+                status = ResumableSearch::Status::NO_PATH;
+            }
+            request.searchMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sliceBegin).count();
+
+            if (status == ResumableSearch::Status::RUNNING) return; // 预算用完，下一帧继续
+            if (status == ResumableSearch::Status::FOUND) request.path = slicedSearch->getPath();
+            publish(request, status == ResumableSearch::Status::FOUND ? PathRequest::Status::READY : PathRequest::Status::NO_PATH);
+        }
+        slicedRequest.reset();
+        slicedSearch.reset();
+        remaining = budgetMicroseconds - std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+    }
+}
+
+// 发布：path与searchMs写入在status的release存储之前完成
+void PathService::publish(PathRequest& request, PathRequest::Status result) {
+    request.status.store(result, std::memory_order_release);
+    if (result == PathRequest::Status::CANCELLED) {
+        cancelledCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    else {
+        completedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// 工作线程：取出查询，跳过已取消的，搜索并发布结果
+void PathService::workerLoop() {
+    PathFinder pathFinder(maze);
+    while (true) {
+        std::shared_ptr<PathRequest> request;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueReady.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) return;
+            request = queue.front();
+            queue.pop_front();
+        }
+
+        if (request->cancelFlag.load(std::memory_order_relaxed)) {
+            publish(*request, PathRequest::Status::CANCELLED);
+            continue;
+        }
+
+        request->status.store(PathRequest::Status::RUNNING, std::memory_order_relaxed);
+        auto begin = std::chrono::steady_clock::now();
+        PathRequest::Status result = PathRequest::Status::READY;
+        try {
+            request->path = pathFinder.findPath(request->algorithm, request->start, request->goal, &request->cancelFlag);
+        }
+        catch (const SearchCancelled&) {
+            result = PathRequest::Status::CANCELLED;
+        }
+        catch (const std::runtime_error&) {
+            result = PathRequest::Status::NO_PATH;
+        }
+        request->searchMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        publish(*request, result);
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef PATH_SERVICE_H
+#define PATH_SERVICE_H
+#include "PathFinder.h"
+#include "ResumableSearch.h"
+#include <memory>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+// 一次异步寻路查询（提交方与工作线程共享）：
+// 工作线程写完path后以release语义发布状态，提交方用acquire读到READY后即可无锁读取path
+class PathRequest {
+public:
+    enum class Status : uint8_t {
+        PENDING,    // 排队中
+        RUNNING,    // 搜索中
+        READY,      // 已完成，path可读
+        NO_PATH,    // 搜索完成但无路径（或起终点非法）
+        CANCELLED   // 被取消或被同一agent的新查询取代
+    };
+
+    Status getStatus() const { return status.load(std::memory_order_acquire); }
+    bool isDone() const { return getStatus() >= Status::READY; }
+    bool isReady() const { return getStatus() == Status::READY; }
+
+    // 仅在isReady()后读取
+    const std::vector<Point>& getPath() const { return path; }
+    int getAgent() const { return agent; }
+    const Point& getStart() const { return start; }
+    const Point& getGoal() const { return goal; }
+    double getSearchMs() const { return searchMs; }   // 搜索耗时（分帧模式为各帧累计；仅完成后有效）
+
+private:
+    friend class PathService;
+    PathRequest(int agent, const Point& start, const Point& goal, SearchAlgorithm algorithm)
+        : agent(agent), start(start), goal(goal), algorithm(algorithm),
+        status(Status::PENDING), cancelFlag(false), searchMs(0.0) {}
+
+    int agent;
+    Point start;
+    Point goal;
+    SearchAlgorithm algorithm;
+    std::atomic<Status> status;
+    std::atomic<bool> cancelFlag;   // 置位后：排队中的直接丢弃，搜索中的在下一次检查时中止
+    std::vector<Point> path;
+    double searchMs;
+};
+
+typedef std::shared_ptr<const PathRequest> PathHandle;
+
+// 异步寻路服务：提交查询后立即返回句柄，搜索在工作线程上进行，游戏每帧轮询句柄即可，渲染线程从不等待搜索。
+// 同一agent的新查询会取消旧查询；request/cancel/pump需在同一线程（通常是主循环）调用。
+// workerCount为0时不创建线程（分帧模式）：查询由主循环每帧调用pump按时间预算推进
+class PathService {
+public:
+    // maze需在服务生命周期内保持有效且不被修改
+    explicit PathService(const Maze& maze, int workerCount = 1);
+    ~PathService();
+
+    PathService(const PathService&) = delete;
+    PathService& operator=(const PathService&) = delete;
+
+    // 提交查询（取代该agent尚未完成的旧查询）
+    PathHandle request(int agent, const Point& start, const Point& goal,
+        SearchAlgorithm algorithm = SearchAlgorithm::DIJKSTRA);
+    // 取消该agent尚未完成的查询
+    void cancel(int agent);
+    // 分帧模式：在预算（微秒）内按提交顺序推进排队的查询；有工作线程时为空操作
+    void pump(double budgetMicroseconds);
+    bool isTimeSliced() const { return workers.empty(); }
+
+    // 统计：已完成/已取消的查询数
+    uint64_t getCompletedCount() const { return completedCount.load(std::memory_order_relaxed); }
+    uint64_t getCancelledCount() const { return cancelledCount.load(std::memory_order_relaxed); }
+
+private:
+    void workerLoop();
+    // 发布结果并计数
+    void publish(PathRequest& request, PathRequest::Status result);
+
+    const Maze& maze;
+    std::vector<std::thread> workers;
+    std::deque<std::shared_ptr<PathRequest>> queue;     // 待处理查询（受queueMutex保护）
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    bool stopping;
+
+    std::unordered_map<int, std::shared_ptr<PathRequest>> latest; // 各agent最近一次查询（仅提交线程访问）
+    std::shared_ptr<PathRequest> slicedRequest;   // 分帧模式：正在推进的查询
+    std::unique_ptr<ResumableSearch> slicedSearch;
+    std::shared_ptr<const CellGrid> slicedGrid;   // 分帧模式：各查询共享的地块网格
+    std::atomic<uint64_t> completedCount;
+    std::atomic<uint64_t> cancelledCount;
+};
+
+#endif // PATH_SERVICE_H
@@ -1,7 +1,8 @@
 #include "Player.h"
-#include "MazeRenderer.h"
+#include "Profiler.h"
+#include <cmath>
 
-// ݵؼ߼
+// 草地减速逻辑
 void Player::updateSpeed(BlockType blockType) {
     switch (blockType) {
     case BlockType::GRASS:
@@ -13,145 +14,104 @@ void Player::updateSpeed(BlockType blockType) {
     }
 }
 
-// ƶƥ侫ͼУ
-void Player::updateDirection(Vector2 moveDir) {
+// 更新移动方向（匹配精灵图行）
+void Player::updateDirection(Vec2 moveDir) {
     if (moveDir.y == 1) {
-        currDir = Direction::DOWN;  // ¼/S0
+        currDir = Direction::DOWN;  // 下键/S：第0行
     }
     else if (moveDir.x == -1) {
-        currDir = Direction::LEFT;  // /A1
+        currDir = Direction::LEFT;  // 左键/A：第1行
     }
     else if (moveDir.x == 1) {
-        currDir = Direction::RIGHT; // Ҽ/D2
+        currDir = Direction::RIGHT; // 右键/D：第2行
     }
     else if (moveDir.y == -1) {
-        currDir = Direction::UP;    // ϼ/W3
+        currDir = Direction::UP;    // 上键/W：第3行
     }
-    frameRect.y = (float)currDir * frameHeight;
 }
 
-// ֡л߼
-void Player::updateAnimation(float deltaTime) {
-    Vector2 moveDir = { 0, 0 };
-    if (IsKeyDown(KEY_UP) || IsKeyDown(KEY_W)) moveDir.y = -1;
-    if (IsKeyDown(KEY_DOWN) || IsKeyDown(KEY_S)) moveDir.y = 1;
-    if (IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A)) moveDir.x = -1;
-    if (IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D)) moveDir.x = 1;
-
-    if (moveDir.x != 0 || moveDir.y != 0) {
+// 动画帧切换逻辑
+void Player::updateAnimation(const InputState& input, float deltaTime) {
+    if (input.hasMove()) {
         timer += deltaTime;
         if (timer >= frameTime) {
             timer = 0.0f;
             currFrame = (currFrame + 1) % frameCols;
-            frameRect.x = (float)currFrame * frameWidth;
         }
     }
     else {
         currFrame = 0;
-        frameRect.x = 0.0f;
         timer = 0.0f;
     }
 }
 
-// ģŲȷײ⣨⴩ǽ
-bool Player::checkFootCollision(const Maze& maze, Vector2 newPixelPos) const {
-    // 1. Ųײеĸ꣨λã
-    // ŲײУھͼײƫfootOffsetYأײհ׵µж
-    float footX = newPixelPos.x + (frameWidth - footCollisionWidth) / 2; // ײXˮƽУ
-    float footY = newPixelPos.y + frameHeight - footCollisionHeight - footOffsetY; // ײYײ
-
-    // 2. Ųײеĸǣϡϡ¡£
-    Vector2 footCorners[4] = {
-        {footX, footY},  // 
-        {footX + footCollisionWidth, footY},  // 
-        {footX, footY + footCollisionHeight},  // 
-        {footX + footCollisionWidth, footY + footCollisionHeight}   // 
+// 脚部碰撞盒：居中在精灵图底部，偏移footOffsetY像素（避免底部空白导致的判定错误）
+Aabb Player::getFootBox(Vec2 atPixelPos) const {
+    return {
+        atPixelPos.x + (frameWidth - footCollisionWidth) / 2,                 // 碰撞盒X（水平居中）
+        atPixelPos.y + frameHeight - footCollisionHeight - footOffsetY,        // 碰撞盒Y（靠近底部）
+        footCollisionWidth,
+        footCollisionHeight
     };
-
-    // 3. ĸǷںϷؿϣǽ+ԹΧڣ
-    for (auto& corner : footCorners) {
-        // ת굽߼ؿ
-        int tileRow = static_cast<int>(corner.y) / MazeRenderer::BLOCK_SIZE;
-        int tileCol = static_cast<int>(corner.x) / MazeRenderer::BLOCK_SIZE;
-
-        // ǷԽ
-        if (tileRow < 0 || tileRow >= maze.rows || tileCol < 0 || tileCol >= maze.cols) {
-            return false; // Խ=ײ
-        }
-
-        // Ƿǽ
-        if (maze.mapData[tileRow][tileCol] == BlockType::WALL) {
-            return false; // ǽ=ײ
-        }
-    }
-
-    return true; // ĸǶϷ=ײ
 }
 
-// ĸ·ƶȷײ
-void Player::update(const Maze& maze, float deltaTime) {
-    // 1. ȡƶ
-    Vector2 moveDir = { 0, 0 };
-    if (IsKeyDown(KEY_UP) || IsKeyDown(KEY_W)) moveDir.y = -1;
-    if (IsKeyDown(KEY_DOWN) || IsKeyDown(KEY_S)) moveDir.y = 1;
-    if (IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A)) moveDir.x = -1;
-    if (IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D)) moveDir.x = 1;
+// 核心更新方法：整合移动、精确碰撞、动画
+void Player::update(const Maze& maze, const CollisionMap& collision, const InputState& input, float deltaTime) {
+    // 0. 保存上一逻辑步位置（渲染插值用）
+    prevPixelPos = pixelPos;
+
+    // 1. 读取移动输入（由前端或模拟器提供）
+    Vec2 moveDir = { 0, 0 };
+    if (input.up) moveDir.y = -1;
+    if (input.down) moveDir.y = 1;
+    if (input.left) moveDir.x = -1;
+    if (input.right) moveDir.x = 1;
 
-    // 2. һƶ
+    // 2. 归一化移动方向
     if (moveDir.x != 0 && moveDir.y != 0) {
         moveDir.x *= 0.7071f;
         moveDir.y *= 0.7071f;
     }
 
-    // 3. ·Ͷ
+    // 3. 更新方向和动画
     if (moveDir.x != 0 || moveDir.y != 0) {
         updateDirection(moveDir);
     }
-    updateAnimation(deltaTime);
+    updateAnimation(input, deltaTime);
 
-    // 4. µ
-    Vector2 newPixelPos = {
-        pixelPos.x + moveDir.x * currentSpeed * deltaTime * 60,
-        pixelPos.y + moveDir.y * currentSpeed * deltaTime * 60
+    // 4. 计算期望位移
+    Vec2 delta = {
+        moveDir.x * currentSpeed * deltaTime * 60,
+        moveDir.y * currentSpeed * deltaTime * 60
     };
-
-    // 5. ȷײ⣺ŲǷᴩǽ
-    if (checkFootCollision(maze, newPixelPos)) {
-        // 6. ײͨλú߼
-        pixelPos = newPixelPos;
-        // µ߼꣨ڽŲģ
-        float footCenterX = newPixelPos.x + frameWidth / 2;
-        /*float footCenterY = newPixelPos.y + frameHeight - footCollisionHeight / 2 - footOffsetY;*/
-        float footCenterY = newPixelPos.y + frameHeight ;
-        int newRow = static_cast<int>(footCenterY) / MazeRenderer::BLOCK_SIZE;
-        int newCol = static_cast<int>(footCenterX) / MazeRenderer::BLOCK_SIZE;
-
-        // 7. Ҽ
-        if (newRow >= 0 && newRow < maze.rows && newCol >= 0 && newCol < maze.cols) {
-            BlockType newBlock = maze.mapData[newRow][newCol];
-            // ݵؼ
-            updateSpeed(newBlock);
-            // Ҽӷҵؿʱ
-            if (newBlock == BlockType::LAVA && maze.mapData[pos.row][pos.col] != BlockType::LAVA) {
-                lavaStepCount++;
-            }
-            // ߼
-            pos = { newRow, newCol };
+    if (delta.x == 0.0f && delta.y == 0.0f) return;
+
+    // 5. 扫掠碰撞：脚部碰撞盒分轴扫过网格，撞墙的分量截断，另一分量继续滑动
+    Aabb footBox = getFootBox(pixelPos);
+    Vec2 moved;
+    {
+        PROFILE_SCOPE("player_collision");
+        moved = GridCollision::move(collision, footBox, delta);
+    }
+    pixelPos.x += moved.x;
+    pixelPos.y += moved.y;
+
+    // 6. 计算新的逻辑坐标（基于脚部碰撞盒中心，碰撞盒不会进入墙格）
+    float footCenterX = footBox.x + moved.x + footBox.width / 2;
+    float footCenterY = footBox.y + moved.y + footBox.height / 2;
+    int newRow = static_cast<int>(std::floor(footCenterY / TILE_SIZE));
+    int newCol = static_cast<int>(std::floor(footCenterX / TILE_SIZE));
+
+    // 7. 处理熔岩计数
+    if (newRow >= 0 && newRow < maze.rows && newCol >= 0 && newCol < maze.cols) {
+        BlockType newBlock = maze.mapData[newRow][newCol];
+        // 草地减速
+        updateSpeed(newBlock);
+        // 熔岩计数（仅从非熔岩地块进入时）
+        if (newBlock == BlockType::LAVA && maze.mapData[pos.row][pos.col] != BlockType::LAVA) {
+            lavaStepCount++;
         }
+        // 更新逻辑坐标
+        pos = { newRow, newCol };
     }
 }
-
-// Ƶǰ֡ѡƽŲײиԣ
-void Player::draw() const {
-    // ƾͼǰ֡
-    DrawTextureRec(charTexture, frameRect, pixelPos, WHITE);
-
-    // ãƽŲײУɫ͸עͣ
-    float footX = pixelPos.x + (frameWidth - footCollisionWidth) / 2;
-    float footY = pixelPos.y + frameHeight - footCollisionHeight - footOffsetY;
-    //DrawRectangle(
-    //    static_cast<int>(footX), static_cast<int>(footY),
-    //    static_cast<int>(footCollisionWidth), static_cast<int>(footCollisionHeight),
-    //    Color{ 0, 255, 0, 100 } // ɫ͸
-    //);
-}
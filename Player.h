@@ -1,53 +1,32 @@
 #ifndef PLAYER_H
 #define PLAYER_H
 #include "MazeParser.h"
-#include "raylib.h"
-#include "MazeRenderer.h"
+#include "PathFinder.h"
+#include "GameTypes.h"
+#include "GridCollision.h"
 
+// 玩家逻辑类（无头核心：移动、碰撞、动画帧推进；纹理与绘制由PlayerSprite负责）
 class Player {
 public:
-    // 죺㡢ͼ·ؼ֡Ĭ34У
-    Player(const Point& startPos, const std::string& charTexPath, int frameCols = 3, int frameRows = 4)
+    // 构造：传入起点、关键帧尺寸、关键帧列数（默认3列）
+    Player(const Point& startPos, int frameWidth = PLAYER_FRAME_WIDTH, int frameHeight = PLAYER_FRAME_HEIGHT, int frameCols = 3)
         : pos(startPos), lavaStepCount(0), baseSpeed(5.0f), currentSpeed(baseSpeed),
-        frameCols(frameCols), frameRows(frameRows), currFrame(0), currDir(Direction::DOWN),
-        timer(0.0f), frameTime(0.3f), footOffsetY(2.0f) { // footOffsetYŲƫƣɵ
-        // 1. ؾͼз+֡
-        Image spriteSheet = LoadImage(charTexPath.c_str());
-        if (spriteSheet.data == nullptr) {
-            throw std::runtime_error("Failed to load sprite sheet: " + charTexPath);
-        }
-        // 2. תΪԴͷڴͼƬ
-        charTexture = LoadTextureFromImage(spriteSheet);
-        UnloadImage(spriteSheet);
-        if (charTexture.id == 0) {
-            throw std::runtime_error("Failed to create texture from sprite sheet");
-        }
-        // 3. 㵥ؼ֡ߴ磨ͼ֣
-        frameWidth = charTexture.width / frameCols;
-        frameHeight = charTexture.height / frameRows;
-        // 4. ʼؼ֡Ĭߵ0֡
-        frameRect = { 0.0f, (float)currDir * frameHeight, (float)frameWidth, (float)frameHeight };
-        // 5. ʼ꣨ʾ3232ؿϣ
+        frameCols(frameCols), frameWidth(frameWidth), frameHeight(frameHeight), currFrame(0), currDir(Direction::DOWN),
+        timer(0.0f), frameTime(0.3f), footOffsetY(2.0f) { // footOffsetY：脚部偏移（可调整）
+        // 1. 初始化像素坐标（居中显示在32×32地块上）
         pixelPos = {
-            MazeRenderer::getBlockPosition(pos.row, pos.col).x + (MazeRenderer::BLOCK_SIZE - frameWidth) / 2,
-            MazeRenderer::getBlockPosition(pos.row, pos.col).y + (MazeRenderer::BLOCK_SIZE - frameHeight) / 2-9.0f
+            static_cast<float>(pos.col * TILE_SIZE) + (TILE_SIZE - frameWidth) / 2,
+            static_cast<float>(pos.row * TILE_SIZE) + (TILE_SIZE - frameHeight) / 2 - 9.0f
         };
-        // 6. ʼŲײ򣨻ھͼߴ磩
-        footCollisionWidth = frameWidth * 0.5f; // Ųײȣͼȵ50%
-        footCollisionHeight = 4.0f;            // Ųײ߶ȣ4أģŵף
-
-    }
-
-    // ͷԴ
-    ~Player() {
-        UnloadTexture(charTexture);
+        prevPixelPos = pixelPos;
+        // 2. 初始化脚部碰撞检测区域（基于关键帧尺寸）
+        footCollisionWidth = frameWidth * 0.5f; // 脚部碰撞宽度（关键帧宽度的50%，避免过宽）
+        footCollisionHeight = 4.0f;            // 脚部碰撞高度（4像素，模拟脚底）
     }
 
-    // £ƶ߼+֡л+ȷײ
-    void update(const Maze& maze, float deltaTime);
-    // ƣƵǰĵǰ֡
-    void draw() const;
-    // ãָʼ״̬
+    // 更新：移动逻辑+动画帧切换+扫掠碰撞（贴墙滑动）
+    void update(const Maze& maze, const CollisionMap& collision, const InputState& input, float deltaTime);
+    // 重置：恢复初始状态
     void reset(const Point& startPos) {
         pos = startPos;
         lavaStepCount = 0;
@@ -55,58 +34,69 @@ public:
         currFrame = 0;
         currDir = Direction::DOWN;
         timer = 0.0f;
-        // ùؼ֡λ
-        frameRect.x = 0.0f;
-        frameRect.y = (float)currDir * frameHeight;
         pixelPos = {
-            MazeRenderer::getBlockPosition(pos.row, pos.col).x + (MazeRenderer::BLOCK_SIZE - frameWidth) / 2,
-            MazeRenderer::getBlockPosition(pos.row, pos.col).y + (MazeRenderer::BLOCK_SIZE - frameHeight) / 2-7.0f
+            static_cast<float>(pos.col * TILE_SIZE) + (TILE_SIZE - frameWidth) / 2,
+            static_cast<float>(pos.row * TILE_SIZE) + (TILE_SIZE - frameHeight) / 2 - 7.0f
         };
+        prevPixelPos = pixelPos; // 重置为瞬移，不做插值
     }
 
     Point getPosition() const { return pos; }
     int getLavaStepCount() const { return lavaStepCount; }
 
-
+    // 渲染所需状态（前端据此截取精灵图）
+    Vec2 getPixelPos() const { return pixelPos; }
+    // 渲染坐标：在上一逻辑步与当前逻辑步之间按alpha插值
+    Vec2 getRenderPos(float alpha) const {
+        return {
+            prevPixelPos.x + (pixelPos.x - prevPixelPos.x) * alpha,
+            prevPixelPos.y + (pixelPos.y - prevPixelPos.y) * alpha
+        };
+    }
+    // 脚部碰撞盒中心（像素坐标，NPC接触判定用）
+    Vec2 getFootCenter() const {
+        Aabb box = getFootBox(pixelPos);
+        return { box.x + box.width / 2, box.y + box.height / 2 };
+    }
+    int getAnimFrame() const { return currFrame; }                 // 当前帧序号（精灵图列）
+    int getAnimRow() const { return static_cast<int>(currDir); }   // 当前方向（精灵图行）
 
 private:
-    // ƶö٣ƥ侫ͼ0=¡1=2=ҡ3=ϣ
+    // 移动方向枚举（匹配精灵图：0=下、1=左、2=右、3=上）
     enum class Direction {
-        DOWN = 0,  // 0У
-        LEFT = 1,  // 1У
-        RIGHT = 2, // 2У
-        UP = 3     // 3У
+        DOWN = 0,  // 第0行：向下走
+        LEFT = 1,  // 第1行：向左走
+        RIGHT = 2, // 第2行：向右走
+        UP = 3     // 第3行：向上走
     };
 
-    // 
-    Point pos;                  // ߼꣨ؿУ
-    int lavaStepCount;          // Ҳд
-    const float baseSpeed;      // ƶٶ
-    float currentSpeed;         // ǰٶȣܲݵӰ죩
-    Vector2 pixelPos;           // ꣨ƽƶã
+    // 核心属性
+    Point pos;                  // 逻辑坐标（地块行列）
+    int lavaStepCount;          // 熔岩踩中次数
+    const float baseSpeed;      // 基础移动速度
+    float currentSpeed;         // 当前速度（受草地影响）
+    Vec2 pixelPos;              // 像素坐标（平滑移动用）
+    Vec2 prevPixelPos;          // 上一逻辑步的像素坐标（渲染插值用）
 
-    // 
-    Texture2D charTexture;      // ͼ
-    Rectangle frameRect;        // ǰؼ֡ȡ
-    int frameCols;              // ͼ
-    int frameRows;              // ͼ
-    int frameWidth;             // ֡
-    int frameHeight;            // ֡߶
-    int currFrame;              // ǰ֡
-    Direction currDir;          // ǰƶ
-    float timer;                // ֡лʱ
-    const float frameTime;      // ÿ֡ʱ
+    // 动画相关属性
+    int frameCols;              // 精灵图列数
+    int frameWidth;             // 单个帧宽度
+    int frameHeight;            // 单个帧高度
+    int currFrame;              // 当前帧序号
+    Direction currDir;          // 当前移动方向
+    float timer;                // 帧切换计时器
+    const float frameTime;      // 每帧播放时间
 
-    // ײԣǽ⣩
-    const float footOffsetY;    // Ųھͼײƫƣλأ
-    float footCollisionWidth;   // Ųײп
-    float footCollisionHeight;  // Ųײи߶
+    // 碰撞检测相关属性（解决穿墙问题）
+    const float footOffsetY;    // 脚部相对于精灵图底部的偏移（单位：像素）
+    float footCollisionWidth;   // 脚部碰撞盒宽度
+    float footCollisionHeight;  // 脚部碰撞盒高度
 
-    // 
-    void updateDirection(Vector2 moveDir);       // ƶ
-    void updateAnimation(float deltaTime);       // ¶֡
-    void updateSpeed(BlockType blockType);       // ݵؼ
-    bool checkFootCollision(const Maze& maze, Vector2 newPixelPos) const; // Ųײ
+    // 辅助方法
+    void updateDirection(Vec2 moveDir);                       // 更新移动方向
+    void updateAnimation(const InputState& input, float deltaTime); // 更新动画帧
+    void updateSpeed(BlockType blockType);                    // 草地减速
+    Aabb getFootBox(Vec2 atPixelPos) const;                   // 脚部碰撞盒
 };
 
-#endif // PLAYER_H
\ No newline at end of file
+#endif // PLAYER_H
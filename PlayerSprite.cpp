@@ -0,0 +1,45 @@
+#include "PlayerSprite.h"
+
+// 构造：加载精灵图并计算关键帧尺寸
+PlayerSprite::PlayerSprite(const std::string& charTexPath, int frameCols, int frameRows)
+    : frameCols(frameCols), frameRows(frameRows) {
+    // 1. 加载精灵图（含所有方向+帧）
+    Image spriteSheet = LoadImage(charTexPath.c_str());
+    if (spriteSheet.data == nullptr) {
+        throw std::runtime_error("Failed to load sprite sheet: " + charTexPath);
+    }
+    // 2. 转换为显存纹理，释放内存图片
+    charTexture = LoadTextureFromImage(spriteSheet);
+    UnloadImage(spriteSheet);
+    if (charTexture.id == 0) {
+        throw std::runtime_error("Failed to create texture from sprite sheet");
+    }
+    // 3. 计算单个关键帧尺寸（精灵图均分）
+    frameWidth = charTexture.width / frameCols;
+    frameHeight = charTexture.height / frameRows;
+}
+
+// 构造：使用已上传的精灵图纹理
+PlayerSprite::PlayerSprite(Texture2D charTexture, int frameCols, int frameRows)
+    : charTexture(charTexture), frameCols(frameCols), frameRows(frameRows) {
+    frameWidth = charTexture.width / frameCols;
+    frameHeight = charTexture.height / frameRows;
+}
+
+// 析构：释放纹理资源
+PlayerSprite::~PlayerSprite() {
+    UnloadTexture(charTexture);
+}
+
+// 绘制当前帧
+void PlayerSprite::draw(const Player& player, float alpha) const {
+    // 根据动画状态截取关键帧区域（列=帧序号，行=方向）
+    Rectangle frameRect = {
+        (float)player.getAnimFrame() * frameWidth,
+        (float)player.getAnimRow() * frameHeight,
+        (float)frameWidth,
+        (float)frameHeight
+    };
+    Vec2 pixelPos = player.getRenderPos(alpha);
+    DrawTextureRec(charTexture, frameRect, Vector2{ pixelPos.x, pixelPos.y }, WHITE);
+}
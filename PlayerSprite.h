@@ -0,0 +1,37 @@
+#ifndef PLAYER_SPRITE_H
+#define PLAYER_SPRITE_H
+#include "Player.h"
+#include "raylib.h"
+#include <string>
+#include <stdexcept>
+
+// 玩家精灵图类（Raylib前端：加载精灵图纹理，按Player的动画状态绘制）
+class PlayerSprite {
+public:
+    // 构造：传入精灵图路径、关键帧行列数（默认3列4行）
+    PlayerSprite(const std::string& charTexPath, int frameCols = 3, int frameRows = 4);
+    // 构造：使用已上传的精灵图纹理（所有权转入本对象）
+    PlayerSprite(Texture2D charTexture, int frameCols = 3, int frameRows = 4);
+    // 析构：释放纹理资源
+    ~PlayerSprite();
+
+    // 绘制：绘制玩家当前方向的当前帧（alpha为逻辑步之间的插值系数）
+    void draw(const Player& player, float alpha = 1.0f) const;
+
+    int getFrameCols() const { return frameCols; }
+    int getFrameWidth() const { return frameWidth; }
+    int getFrameHeight() const { return frameHeight; }
+
+    // 禁用拷贝（避免纹理重复释放）
+    PlayerSprite(const PlayerSprite&) = delete;
+    PlayerSprite& operator=(const PlayerSprite&) = delete;
+
+private:
+    Texture2D charTexture;      // 精灵图纹理
+    int frameCols;              // 精灵图列数
+    int frameRows;              // 精灵图行数
+    int frameWidth;             // 单个帧宽度
+    int frameHeight;            // 单个帧高度
+};
+
+#endif // PLAYER_SPRITE_H
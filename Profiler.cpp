@@ -0,0 +1,100 @@
+#include "Profiler.h"
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace {
+    // 各线程缓冲登记表（只在线程首次记录时加锁登记；缓冲在进程结束前不释放，线程退出后仍可导出）
+    std::mutex& registryMutex() { static std::mutex value; return value; }
+    std::vector<std::unique_ptr<ProfileRing>>& registry() {
+        static std::vector<std::unique_ptr<ProfileRing>> value;
+        return value;
+    }
+
+    // 所有线程的事件快照：(线程序号, 事件)
+    std::vector<std::pair<uint32_t, ProfileEvent>> collectAll() {
+        std::vector<std::pair<uint32_t, ProfileEvent>> all;
+        std::vector<ProfileEvent> events;
+        std::lock_guard<std::mutex> lock(registryMutex());
+        for (const auto& ring : registry()) {
+            events.clear();
+            ring->snapshot(events);
+            for (const ProfileEvent& e : events) {
+                all.push_back({ ring->getThreadIndex(), e });
+            }
+        }
+        return all;
+    }
+}
+
+// 读取仍保留的事件；读后再检查head，丢弃拷贝期间可能被写入方覆盖的最旧部分
+void ProfileRing::snapshot(std::vector<ProfileEvent>& out, size_t maxEvents) const {
+    size_t end = head.load(std::memory_order_acquire);
+    size_t keep = std::min(maxEvents, CAPACITY);
+    size_t begin = end > keep ? end - keep : 0;
+    size_t base = out.size();
+    for (size_t i = begin; i < end; ++i) {
+        out.push_back(events[i & (CAPACITY - 1)]);
+    }
+    size_t after = head.load(std::memory_order_acquire);
+    if (after > begin + CAPACITY) {
+        size_t overwritten = std::min(end - begin, after - CAPACITY - begin);
+        out.erase(out.begin() + base, out.begin() + base + overwritten);
+    }
+}
+
+// 当前线程的缓冲（首次调用时创建并登记）
+ProfileRing& Profiler::threadRing() {
+    thread_local ProfileRing* ring = nullptr;
+    if (ring == nullptr) {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        registry().emplace_back(new ProfileRing(static_cast<uint32_t>(registry().size())));
+        ring = registry().back().get();
+    }
+    return *ring;
+}
+
+void Profiler::record(const char* name, uint64_t startNs, uint64_t endNs) {
+    uint64_t duration = endNs - startNs;
+    threadRing().push({ name, startNs, static_cast<uint32_t>(duration > UINT32_MAX ? UINT32_MAX : duration), currentFrame() });
+}
+
+void Profiler::snapshotCurrentThread(std::vector<ProfileEvent>& out, size_t maxEvents) {
+    threadRing().snapshot(out, maxEvents);
+}
+
+// CSV：每行一个区段
+void Profiler::writeCsv(const std::string& filePath) {
+    std::ofstream file(filePath);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open profile CSV: " + filePath);
+    }
+    file << std::fixed << std::setprecision(3);
+    file << "thread,frame,zone,startUs,durationUs\n";
+    for (const auto& item : collectAll()) {
+        const ProfileEvent& e = item.second;
+        file << item.first << ',' << e.frame << ',' << e.name << ','
+            << e.startNs / 1000.0 << ',' << e.durationNs / 1000.0 << '\n';
+    }
+}
+
+// Chrome trace（Trace Event格式的完整事件"X"，时间单位微秒）
+void Profiler::writeChromeTrace(const std::string& filePath) {
+    std::ofstream file(filePath);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open profile trace: " + filePath);
+    }
+    std::vector<std::pair<uint32_t, ProfileEvent>> all = collectAll();
+    file << std::fixed << std::setprecision(3);
+    file << "{\"traceEvents\":[\n";
+    for (size_t i = 0; i < all.size(); ++i) {
+        const ProfileEvent& e = all[i].second;
+        file << "{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << all[i].first
+            << ",\"ts\":" << e.startNs / 1000.0 << ",\"dur\":" << e.durationNs / 1000.0
+            << ",\"args\":{\"frame\":" << e.frame << "}}" << (i + 1 < all.size() ? ",\n" : "\n");
+    }
+    file << "]}\n";
+}
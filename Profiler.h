@@ -0,0 +1,105 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+#include <atomic>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+// 单个计时区段事件
+struct ProfileEvent {
+    const char* name;     // 区段名（须为字符串字面量等静态存储的字符串）
+    uint64_t startNs;     // 起始时间（相对进程内计时起点，纳秒）
+    uint32_t durationNs;  // 持续时间（纳秒）
+    uint32_t frame;       // 所属帧序号
+};
+
+// 每线程一个的环形缓冲：只有所属线程写入（单生产者），写满后覆盖最旧事件；
+// 写入不加锁，读取方按head快照拷贝
+class ProfileRing {
+public:
+    static const size_t CAPACITY = 1 << 14; // 容量（2的幂），约可容纳最近两千帧的全部区段
+
+    explicit ProfileRing(uint32_t threadIndex) : threadIndex(threadIndex), head(0), events(CAPACITY) {}
+
+    void push(const ProfileEvent& event) {
+        size_t index = head.load(std::memory_order_relaxed);
+        events[index & (CAPACITY - 1)] = event;
+        head.store(index + 1, std::memory_order_release);
+    }
+
+    // 把仍保留在缓冲中最近的至多maxEvents个事件按写入顺序追加到out
+    void snapshot(std::vector<ProfileEvent>& out, size_t maxEvents = CAPACITY) const;
+
+    uint32_t getThreadIndex() const { return threadIndex; }
+
+private:
+    uint32_t threadIndex;
+    std::atomic<size_t> head;          // 累计写入数（取模后为下一个写入位置）
+    std::vector<ProfileEvent> events;
+};
+
+// 帧剖析器：全局开关 + 帧计数 + 各线程环形缓冲的登记表；导出CSV或Chrome trace（chrome://tracing可直接打开）
+class Profiler {
+public:
+    static bool isEnabled() { return enabledFlag().load(std::memory_order_relaxed); }
+    static void setEnabled(bool enabled) { enabledFlag().store(enabled, std::memory_order_relaxed); }
+
+    // 主循环每帧开头调用一次
+    static void beginFrame() { frameCounter().fetch_add(1, std::memory_order_relaxed); }
+    static uint32_t currentFrame() { return frameCounter().load(std::memory_order_relaxed); }
+
+    // 相对计时起点的纳秒数
+    static uint64_t nowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - epoch()).count());
+    }
+
+    // 记录一个事件到当前线程的缓冲
+    static void record(const char* name, uint64_t startNs, uint64_t endNs);
+
+    // 当前线程缓冲中最近的事件（叠加图使用）
+    static void snapshotCurrentThread(std::vector<ProfileEvent>& out, size_t maxEvents = ProfileRing::CAPACITY);
+
+    // 导出全部线程的事件（失败时抛出异常）
+    static void writeCsv(const std::string& filePath);
+    static void writeChromeTrace(const std::string& filePath);
+
+private:
+    static std::atomic<bool>& enabledFlag() { static std::atomic<bool> value(false); return value; }
+    static std::atomic<uint32_t>& frameCounter() { static std::atomic<uint32_t> value(0); return value; }
+    static std::chrono::steady_clock::time_point epoch() {
+        static const std::chrono::steady_clock::time_point value = std::chrono::steady_clock::now();
+        return value;
+    }
+    static ProfileRing& threadRing();
+};
+
+// 作用域计时器：构造时记下起点，析构时写入事件（剖析器关闭时只读一次开关）
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+        : name(name), active(Profiler::isEnabled()), startNs(active ? Profiler::nowNs() : 0) {}
+    ~ProfileScope() {
+        if (active) Profiler::record(name, startNs, Profiler::nowNs());
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    bool active;
+    uint64_t startNs;
+};
+
+// 区段宏：定义MAZE_NO_PROFILER时编译为空（CMake选项MAZE_PROFILER=OFF）
+#ifdef MAZE_NO_PROFILER
+#define PROFILE_SCOPE(name) ((void)0)
+#else
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#endif
+
+#endif // PROFILER_H
@@ -0,0 +1,89 @@
+#include "ProfilerOverlay.h"
+#include "raylib.h"
+#include <cstring>
+
+namespace {
+    // 区段显示样式；前STACKED_ZONES个互不嵌套，按顺序堆叠成柱，其余（嵌套在update内）只列平均值
+    struct ZoneStyle {
+        const char* name;
+        Color color;
+    };
+    const ZoneStyle ZONES[] = {
+        { "input",            SKYBLUE },
+        { "update",           ORANGE },
+        { "maze_draw",        DARKGREEN },
+        { "sprites",          PURPLE },
+        { "ui_text",          GOLD },
+        { "end_drawing",      LIGHTGRAY },
+        { "player_collision", MAROON },
+        { "slimes",           RED }
+    };
+    const int ZONE_COUNT = sizeof(ZONES) / sizeof(ZONES[0]);
+    const int STACKED_ZONES = 6;
+
+    const int GRAPH_HEIGHT = 80;            // 柱状图高度（像素）
+    const float GRAPH_MAX_MS = 20.0f;       // 图高对应的毫秒数
+    const float FRAME_BUDGET_MS = 1000.0f / 60.0f;
+
+    int zoneIndex(const char* name) {
+        for (int i = 0; i < ZONE_COUNT; ++i) {
+            if (std::strcmp(ZONES[i].name, name) == 0) return i;
+        }
+        return -1;
+    }
+}
+
+// 绘制叠加图：只统计已结束的帧（当前帧尚未记录完整）
+void ProfilerOverlay::draw(int x, int y, const FrameAllocCounter& allocs) {
+    const int graphWidth = HISTORY_FRAMES * 2;
+    DrawRectangle(x, y, graphWidth + 150, GRAPH_HEIGHT + 20, Color{ 0, 0, 0, 170 });
+    if (!Profiler::isEnabled()) {
+        DrawText("profiler disabled", x + 6, y + 6, 10, WHITE);
+        return;
+    }
+
+    // 1. 按帧、区段累加耗时
+    float ms[HISTORY_FRAMES][ZONE_COUNT] = {};
+    uint32_t current = Profiler::currentFrame();
+    events.clear();
+    Profiler::snapshotCurrentThread(events, HISTORY_FRAMES * 16);
+    for (const ProfileEvent& e : events) {
+        if (e.frame >= current || current - e.frame > static_cast<uint32_t>(HISTORY_FRAMES)) continue;
+        int zone = zoneIndex(e.name);
+        if (zone < 0) continue;
+        ms[HISTORY_FRAMES - (current - e.frame)][zone] += e.durationNs / 1e6f;
+    }
+
+    // 2. 堆叠柱状图 + 60FPS预算线
+    const int baseY = y + 10 + GRAPH_HEIGHT;
+    const float pixelsPerMs = GRAPH_HEIGHT / GRAPH_MAX_MS;
+    float sum[ZONE_COUNT] = {};
+    for (int frame = 0; frame < HISTORY_FRAMES; ++frame) {
+        float top = 0.0f;
+        for (int zone = 0; zone < ZONE_COUNT; ++zone) {
+            sum[zone] += ms[frame][zone];
+            if (zone >= STACKED_ZONES) continue;
+            float height = ms[frame][zone] * pixelsPerMs;
+            if (top + height > GRAPH_HEIGHT) height = GRAPH_HEIGHT - top;
+            if (height <= 0.0f) continue;
+            DrawRectangle(x + 5 + frame * 2, baseY - static_cast<int>(top + height), 2, static_cast<int>(height) + 1, ZONES[zone].color);
+            top += height;
+        }
+    }
+    int budgetY = baseY - static_cast<int>(FRAME_BUDGET_MS * pixelsPerMs);
+    DrawLine(x + 5, budgetY, x + 5 + graphWidth, budgetY, RED);
+
+    // 3. 图例：各区段平均耗时
+    for (int zone = 0; zone < ZONE_COUNT; ++zone) {
+        int textY = y + 6 + zone * 11;
+        DrawRectangle(x + graphWidth + 12, textY + 1, 8, 8, ZONES[zone].color);
+        DrawText(TextFormat("%s %.2fms", ZONES[zone].name, sum[zone] / HISTORY_FRAMES), x + graphWidth + 24, textY, 10, WHITE);
+    }
+
+    // 4. 堆分配：上一帧次数 / 发生分配的帧数（稳态帧应为0，非0时标红）
+    if (AllocTracker::isHooked()) {
+        DrawText(TextFormat("alloc %d/frame (%d of %d frames)", static_cast<int>(allocs.getLastFrameAllocations()),
+            static_cast<int>(allocs.getAllocatingFrames()), static_cast<int>(allocs.getFrameCount())),
+            x + 6, y + 6, 10, allocs.getLastFrameAllocations() == 0 ? WHITE : RED);
+    }
+}
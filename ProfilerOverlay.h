@@ -0,0 +1,19 @@
+#ifndef PROFILER_OVERLAY_H
+#define PROFILER_OVERLAY_H
+#include "Profiler.h"
+#include "AllocTracker.h"
+#include <vector>
+
+// 剖析叠加图（Raylib前端）：最近若干帧各区段耗时的堆叠柱状图 + 各区段平均耗时
+class ProfilerOverlay {
+public:
+    static const int HISTORY_FRAMES = 120;  // 显示的帧数（每帧一根2像素宽的柱）
+
+    // 在(x, y)处绘制（须在BeginDrawing/EndDrawing之间调用）；链接了分配钩子时附带上一帧的堆分配次数
+    void draw(int x, int y, const FrameAllocCounter& allocs);
+
+private:
+    std::vector<ProfileEvent> events; // 事件快照（复用，避免每帧分配）
+};
+
+#endif // PROFILER_OVERLAY_H
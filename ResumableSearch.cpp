@@ -0,0 +1,176 @@
+#include "ResumableSearch.h"
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <utility>
+
+namespace {
+    const int DIRS[4][2] = { {-1,0}, {1,0}, {0,-1}, {0,1} };
+    const unsigned CLOCK_CHECK_INTERVAL = 64; // 每扩展多少个节点读一次时钟
+}
+
+ResumableSearch::ResumableSearch(const Maze& maze, SearchAlgorithm algorithm, const Point& start, const Point& goal)
+    : ResumableSearch(std::make_shared<const CellGrid>(maze, CellGrid::preferredLayout(maze)), algorithm, start, goal) {
+}
+
+// 构造：初始化状态数组并把起点放入队列/堆
+ResumableSearch::ResumableSearch(std::shared_ptr<const CellGrid> grid, SearchAlgorithm algorithm, const Point& start, const Point& goal)
+    : grid(std::move(grid)), algorithm(algorithm), start(start), goal(goal),
+    layers(algorithm == SearchAlgorithm::LAVA_ONCE ? 2 : 1),
+    status(Status::RUNNING), fifoHead(0), goalState(-1), bestState(-1), bestHeuristic(INT_MAX), expanded(0) {
+    const CellGrid& cells = *this->grid;
+    auto legal = [&cells](const Point& p) {
+        return p.row >= 0 && p.row < cells.getRows() && p.col >= 0 && p.col < cells.getCols()
+            && cells.at(cells.index(p.row, p.col)) != BlockType::WALL;
+    };
+    if (!legal(start) || !legal(goal)) {
+        throw std::runtime_error("Path query endpoint is outside the maze or inside a wall");
+    }
+
+    size_t states = cells.getCellCount() * layers;
+    dist.assign(states, INT_MAX);
+    prev.assign(states, -1);
+    pushState(cells.index(start.row, start.col) * layers, (start.row * cells.getCols() + start.col) * layers, 0, -1);
+}
+
+void ResumableSearch::pushState(int state, int order, int newDist, int from) {
+    dist[state] = newDist;
+    prev[state] = from;
+    if (algorithm == SearchAlgorithm::BFS) {
+        fifo.push_back(state);
+    }
+    else {
+        heap.push_back({ newDist, order, state });
+        std::push_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+    }
+}
+
+// 扩展一个节点（出队时判断终点，与PathFinder一致：出队即最短）
+bool ResumableSearch::expandOne() {
+    int state;
+    if (algorithm == SearchAlgorithm::BFS) {
+        if (fifoHead == fifo.size()) {
+            status = Status::NO_PATH;
+            return false;
+        }
+        state = fifo[fifoHead++];
+    }
+    else {
+        while (true) {
+            if (heap.empty()) {
+                status = Status::NO_PATH;
+                return false;
+            }
+            std::pop_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+            HeapEntry top = heap.back();
+            heap.pop_back();
+            if (top.dist <= dist[top.state]) {
+                state = top.state;
+                break;
+            }
+            // 过期条目：该状态已有更短距离，跳过
+        }
+    }
+
+    const CellGrid& cells = *grid;
+    const int cell = state / layers;
+    const bool hasLava = state % layers == 1;
+    const Point pos = cells.position(cell);
+    const int row = pos.row, col = pos.col;
+    ++expanded;
+
+    int heuristic = std::abs(row - goal.row) + std::abs(col - goal.col);
+    if (heuristic < bestHeuristic) {
+        bestHeuristic = heuristic;
+        bestState = state;
+    }
+    if (row == goal.row && col == goal.col) {
+        goalState = state;
+        status = Status::FOUND;
+        return false;
+    }
+
+    const int curDist = dist[state];
+    for (int d = 0; d < 4; ++d) {
+        // 邻格序号由网格按布局给出（分块布局下上下邻格多在同一块内）
+        int newCell = cells.neighbor(cell, row, col, d);
+        if (newCell < 0) continue;
+        BlockType block = cells.at(newCell);
+        if (block == BlockType::WALL) continue;
+
+        int newState, cost;
+        switch (algorithm) {
+        case SearchAlgorithm::BFS:
+            newState = newCell;
+            cost = 1;
+            break;
+        case SearchAlgorithm::DIJKSTRA:
+            newState = newCell;
+            cost = PathFinder::tileCost(block);
+            break;
+        default:
+            // 熔岩1次：踩熔岩不计成本但进入“已踩”层，已踩过则不能再踩
+            if (block == BlockType::LAVA) {
+                if (hasLava) continue;
+                newState = newCell * 2 + 1;
+                cost = 0;
+            }
+            else {
+                newState = newCell * 2 + (hasLava ? 1 : 0);
+                cost = PathFinder::tileCost(block);
+            }
+            break;
+        }
+
+        if (algorithm == SearchAlgorithm::BFS) {
+            if (dist[newState] == INT_MAX) pushState(newState, 0, curDist + 1, state);
+        }
+        else if (curDist + cost < dist[newState]) {
+            const int order = ((row + DIRS[d][0]) * cells.getCols() + col + DIRS[d][1]) * layers + newState % layers;
+            pushState(newState, order, curDist + cost, state);
+        }
+    }
+    return true;
+}
+
+ResumableSearch::Status ResumableSearch::step(double budgetMicroseconds) {
+    if (status != Status::RUNNING) return status;
+    auto deadline = std::chrono::steady_clock::now()
+        + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::micro>(budgetMicroseconds));
+    unsigned sinceCheck = 0;
+    while (expandOne()) {
+        if (++sinceCheck == CLOCK_CHECK_INTERVAL) {
+            sinceCheck = 0;
+            if (std::chrono::steady_clock::now() >= deadline) break;
+        }
+    }
+    return status;
+}
+
+ResumableSearch::Status ResumableSearch::run() {
+    while (expandOne()) {
+    }
+    return status;
+}
+
+std::vector<Point> ResumableSearch::tracePath(int state) const {
+    std::vector<Point> path;
+    for (int cur = state; cur != -1; cur = prev[cur]) {
+        path.push_back(grid->position(cur / layers));
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+std::vector<Point> ResumableSearch::getPath() const {
+    if (status != Status::FOUND) return std::vector<Point>();
+    return tracePath(goalState);
+}
+
+std::vector<Point> ResumableSearch::getBestPartialPath() const {
+    if (status == Status::FOUND) return tracePath(goalState);
+    if (bestState < 0) return std::vector<Point>(1, start);
+    return tracePath(bestState);
+}
@@ -0,0 +1,78 @@
+#ifndef RESUMABLE_SEARCH_H
+#define RESUMABLE_SEARCH_H
+#include "PathFinder.h"
+#include "CellGrid.h"
+#include <vector>
+#include <memory>
+
+// 可分帧推进的寻路搜索（BFS/Dijkstra/熔岩1次，成本模型与PathFinder一致）：
+// 搜索状态（距离、前驱、队列/堆）全部保存在对象内，step按时间预算推进后返回，下一帧继续。
+// 适用于没有空闲工作线程的平台：每帧只花固定预算，大迷宫的搜索分摊到多帧完成
+class ResumableSearch {
+public:
+    enum class Status {
+        RUNNING,   // 尚未结束，可继续step
+        FOUND,     // 已找到终点，getPath可用
+        NO_PATH    // 搜索空间耗尽仍未到达终点
+    };
+
+    // 起终点越界或为墙时抛出runtime_error。使用默认地块布局（见CellGrid::preferredLayout）
+    ResumableSearch(const Maze& maze, SearchAlgorithm algorithm, const Point& start, const Point& goal);
+    // 使用现成的地块网格（多次查询可共享同一份，也可指定布局）
+    ResumableSearch(std::shared_ptr<const CellGrid> grid, SearchAlgorithm algorithm, const Point& start, const Point& goal);
+
+    // 推进搜索直到用完预算（微秒）或搜索结束；每64次扩展检查一次时间，预算再小也至少前进一批
+    Status step(double budgetMicroseconds);
+    // 不限时间一次跑完
+    Status run();
+
+    Status getStatus() const { return status; }
+    // 完整路径（仅FOUND时非空）
+    std::vector<Point> getPath() const;
+    // 目前已扩展节点中离终点最近（曼哈顿距离）者的路径，用于搜索未完成时先走起来
+    std::vector<Point> getBestPartialPath() const;
+
+    long long getExpandedCount() const { return expanded; }
+    const Point& getStart() const { return start; }
+    const Point& getGoal() const { return goal; }
+    CellLayout getLayout() const { return grid->getLayout(); }
+
+private:
+    // 扩展一个节点；搜索结束时返回false
+    bool expandOne();
+    // 从状态沿前驱回溯到起点
+    std::vector<Point> tracePath(int state) const;
+    // order为行主序状态号（只用于Dijkstra堆的平局次序，BFS忽略）
+    void pushState(int state, int order, int newDist, int from);
+
+    // Dijkstra堆条目：同距离时按行主序的(行, 列, 层)出堆，因此任何布局下扩展顺序和找到的路径都相同
+    struct HeapEntry {
+        int dist;
+        int order;   // 行主序状态号（只用于打破平局）
+        int state;   // 按网格布局的状态号
+        bool operator>(const HeapEntry& other) const {
+            return dist != other.dist ? dist > other.dist : order > other.order;
+        }
+    };
+
+    std::shared_ptr<const CellGrid> grid;
+    SearchAlgorithm algorithm;
+    Point start;
+    Point goal;
+    int layers;                  // 每格状态数（熔岩1次为2：未踩/已踩熔岩，其余为1）
+    Status status;
+
+    // 状态号 = 网格序号 * layers + 层，与地块一样按网格布局排列
+    std::vector<int> dist;       // 状态 → 已知最短距离（INT_MAX为未到达）
+    std::vector<int> prev;       // 状态 → 前驱状态（-1为无）
+    std::vector<int> fifo;       // BFS队列（head之前为已出队）
+    size_t fifoHead;
+    std::vector<HeapEntry> heap; // Dijkstra小根堆
+
+    int goalState;               // 到达终点的状态（FOUND时有效）
+    int bestState;               // 离终点最近的已扩展状态
+    int bestHeuristic;           // bestState到终点的曼哈顿距离
+    long long expanded;
+};
+
+#endif // RESUMABLE_SEARCH_H
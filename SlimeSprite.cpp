@@ -0,0 +1,56 @@
+#include "SlimeSprite.h"
+#include <cmath>
+
+// 构造：加载共享纹理并计算关键帧尺寸
+SlimeSprite::SlimeSprite(const std::string& texPath, int frameCols, int frameRows)
+    : frameCols(frameCols), frameTime(0.3f) {
+    texture = LoadTexture(texPath.c_str());
+    if (texture.id == 0) {
+        throw std::runtime_error("Failed to load slime texture: " + texPath);
+    }
+    frameWidth = texture.width / frameCols;
+    frameHeight = texture.height / frameRows;
+}
+
+// 构造：使用已上传的纹理
+SlimeSprite::SlimeSprite(Texture2D texture, int frameCols, int frameRows)
+    : texture(texture), frameCols(frameCols), frameTime(0.3f) {
+    frameWidth = texture.width / frameCols;
+    frameHeight = texture.height / frameRows;
+}
+
+// 析构：释放纹理资源
+SlimeSprite::~SlimeSprite() {
+    UnloadTexture(texture);
+}
+
+// 批量绘制所有史莱姆（缩放到一个地块大小，中心对齐NPC位置）
+void SlimeSprite::drawAll(const SlimeSwarm& swarm, float alpha, const FieldOfView* fov) const {
+    const size_t n = swarm.size();
+    if (n == 0) return;
+
+    const float* px = swarm.getPosX().data();
+    const float* py = swarm.getPosY().data();
+    const float* prevX = swarm.getPrevPosX().data();
+    const float* prevY = swarm.getPrevPosY().data();
+    const float* vx = swarm.getVelX().data();
+    const float* vy = swarm.getVelY().data();
+    const int baseFrame = static_cast<int>(swarm.getAnimTimer() / frameTime);
+    const float size = static_cast<float>(TILE_SIZE);
+
+    for (size_t i = 0; i < n; ++i) {
+        if (fov != nullptr && !fov->isVisible(static_cast<int>(py[i]) / TILE_SIZE, static_cast<int>(px[i]) / TILE_SIZE)) continue;
+        // 朝向行（0=下、1=左、2=右、3=上），按速度主方向选择
+        int row;
+        if (std::fabs(vx[i]) > std::fabs(vy[i])) row = vx[i] < 0 ? 1 : 2;
+        else row = vy[i] < 0 ? 3 : 0;
+        // 帧序号按NPC序号错开，避免整群动作同步
+        int frame = (baseFrame + static_cast<int>(i)) % frameCols;
+
+        float x = prevX[i] + (px[i] - prevX[i]) * alpha;
+        float y = prevY[i] + (py[i] - prevY[i]) * alpha;
+        Rectangle source = { (float)frame * frameWidth, (float)row * frameHeight, (float)frameWidth, (float)frameHeight };
+        Rectangle dest = { x - size / 2, y - size / 2, size, size };
+        DrawTexturePro(texture, source, dest, Vector2{ 0, 0 }, 0.0f, WHITE);
+    }
+}
@@ -0,0 +1,35 @@
+#ifndef SLIME_SPRITE_H
+#define SLIME_SPRITE_H
+#include "SlimeSwarm.h"
+#include "FieldOfView.h"
+#include "raylib.h"
+#include <string>
+#include <stdexcept>
+
+// 史莱姆精灵图类（Raylib前端：所有NPC共用一张纹理，一次循环批量绘制）
+class SlimeSprite {
+public:
+    // 构造：传入精灵图路径、关键帧行列数（默认3列4行，与角色精灵图排布一致）
+    SlimeSprite(const std::string& texPath, int frameCols = 3, int frameRows = 4);
+    // 构造：使用已上传的纹理（所有权转入本对象）
+    SlimeSprite(Texture2D texture, int frameCols = 3, int frameRows = 4);
+    // 析构：释放纹理资源
+    ~SlimeSprite();
+
+    // 批量绘制：连续提交同一纹理的矩形，Raylib内部合并为同一批次（alpha为逻辑步插值系数；
+    // fov非空时只画所在格当前可见的史莱姆）
+    void drawAll(const SlimeSwarm& swarm, float alpha = 1.0f, const FieldOfView* fov = nullptr) const;
+
+    // 禁用拷贝（避免纹理重复释放）
+    SlimeSprite(const SlimeSprite&) = delete;
+    SlimeSprite& operator=(const SlimeSprite&) = delete;
+
+private:
+    Texture2D texture;          // 共享纹理
+    int frameCols;              // 精灵图列数
+    int frameWidth;             // 单个帧宽度
+    int frameHeight;            // 单个帧高度
+    const float frameTime;      // 每帧播放时间
+};
+
+#endif // SLIME_SPRITE_H
@@ -0,0 +1,137 @@
+#include "SlimeSwarm.h"
+#include "GridCollision.h"
+#include <random>
+#include <cmath>
+
+// 随机生成NPC（只放在可达且离目标足够远的格子中心）
+void SlimeSwarm::spawn(const CollisionMap& collision, const FlowField& field, int count, unsigned seed, int minDistance) {
+    clear();
+
+    std::vector<int> candidates;
+    const int cols = collision.getCols();
+    const int cellCount = collision.getRows() * cols;
+    for (int cell = 0; cell < cellCount; ++cell) {
+        if (field.distanceAt(cell) >= minDistance) {
+            candidates.push_back(cell);
+        }
+    }
+    if (candidates.empty() || count <= 0) return;
+
+    std::mt19937 rng(seed);
+    posX.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        int cell = candidates[rng() % candidates.size()];
+        float x = (cell % cols) * TILE_SIZE + TILE_SIZE * 0.5f;
+        float y = (cell / cols) * TILE_SIZE + TILE_SIZE * 0.5f;
+        posX.push_back(x);
+        posY.push_back(y);
+        prevX.push_back(x);
+        prevY.push_back(y);
+        velX.push_back(0.0f);
+        velY.push_back(0.0f);
+        tile.push_back(cell);
+        state.push_back(State::CHASING);
+    }
+    nextX.resize(count);
+    nextY.resize(count);
+    sweepList.reserve(count);
+}
+
+void SlimeSwarm::clear() {
+    posX.clear(); posY.clear();
+    prevX.clear(); prevY.clear();
+    velX.clear(); velY.clear();
+    tile.clear(); state.clear();
+    nextX.clear(); nextY.clear();
+    sweepList.clear();
+}
+
+// 批量更新：各阶段分别遍历连续数组
+void SlimeSwarm::update(const CollisionMap& collision, const FlowField& field, float deltaTime) {
+    const int n = static_cast<int>(posX.size());
+    if (n == 0) return;
+    animTimer += deltaTime;
+
+    const int cols = collision.getCols();
+    const float* stepX = field.stepTargetX();
+    const float* stepY = field.stepTargetY();
+    const int* dist = field.distances();
+    const float maxStep = speed * deltaTime * 60;  // 与玩家相同：速度按60Hz逻辑帧定义
+
+    float* px = posX.data();
+    float* py = posY.data();
+    float* vx = velX.data();
+    float* vy = velY.data();
+    float* nx = nextX.data();
+    float* ny = nextY.data();
+    const int* t = tile.data();
+
+    // 1. 保存上一步坐标
+    prevX = posX;
+    prevY = posY;
+
+    // 2. 转向：按所在格查流场，朝下一格中心前进（收集阶段，逐个查表）
+    for (int i = 0; i < n; ++i) {
+        nx[i] = stepX[t[i]];
+        ny[i] = stepY[t[i]];
+        state[i] = dist[t[i]] > 0 ? State::CHASING : State::IDLE;
+    }
+
+    // 3. 积分：纯算术循环，无分支依赖，可自动向量化
+    for (int i = 0; i < n; ++i) {
+        float dx = nx[i] - px[i];
+        float dy = ny[i] - py[i];
+        float len = std::sqrt(dx * dx + dy * dy);
+        float scale = len > maxStep ? maxStep / len : 1.0f;  // 不越过目标点
+        vx[i] = dx * scale;
+        vy[i] = dy * scale;
+        nx[i] = px[i] + vx[i];
+        ny[i] = py[i] + vy[i];
+    }
+
+    // 4. 碰撞快速路径：所在格距墙≥2格时，16像素碰撞盒小步移动不可能碰墙，直接接受
+    sweepList.clear();
+    for (int i = 0; i < n; ++i) {
+        if (collision.distanceToWall(t[i] / cols, t[i] % cols) >= 2) {
+            px[i] = nx[i];
+            py[i] = ny[i];
+        }
+        else {
+            sweepList.push_back(i);
+        }
+    }
+
+    // 5. 靠墙的NPC走扫掠碰撞（贴墙滑动）
+    const float half = SLIME_SIZE * 0.5f;
+    for (int i : sweepList) {
+        Aabb box = { px[i] - half, py[i] - half, static_cast<float>(SLIME_SIZE), static_cast<float>(SLIME_SIZE) };
+        Vec2 moved = GridCollision::move(collision, box, Vec2{ vx[i], vy[i] });
+        px[i] += moved.x;
+        py[i] += moved.y;
+    }
+
+    // 6. 更新所在格，速度换算为像素/秒（渲染朝向用）
+    const float invDt = deltaTime > 0 ? 1.0f / deltaTime : 0.0f;
+    for (int i = 0; i < n; ++i) {
+        int row = static_cast<int>(py[i]) / TILE_SIZE;
+        int col = static_cast<int>(px[i]) / TILE_SIZE;
+        tile[i] = row * cols + col;
+        vx[i] *= invDt;
+        vy[i] *= invDt;
+    }
+}
+
+// 是否有NPC进入半径范围（平方距离比较，无开方）
+bool SlimeSwarm::anyWithin(float x, float y, float radius) const {
+    const int n = static_cast<int>(posX.size());
+    const float r2 = radius * radius;
+    const float* px = posX.data();
+    const float* py = posY.data();
+    int hits = 0;
+    for (int i = 0; i < n; ++i) {
+        float dx = px[i] - x;
+        float dy = py[i] - y;
+        hits += (dx * dx + dy * dy < r2) ? 1 : 0;
+    }
+    return hits > 0;
+}
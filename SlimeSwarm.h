@@ -0,0 +1,64 @@
+#ifndef SLIME_SWARM_H
+#define SLIME_SWARM_H
+#include "CollisionMap.h"
+#include "FlowField.h"
+#include "GameTypes.h"
+#include <vector>
+#include <cstdint>
+
+// 史莱姆群（无头核心）：大量NPC按结构体数组（SoA）存储，
+// 每个属性一条连续数组，移动按批次逐数组处理，便于编译器自动向量化。
+class SlimeSwarm {
+public:
+    // NPC状态
+    enum class State : uint8_t {
+        IDLE = 0,    // 原地不动（目标不可达或已到达）
+        CHASING = 1  // 沿流场追踪目标
+    };
+
+    static const int SLIME_SIZE = 16;  // 碰撞盒边长（像素，以位置为中心）
+
+    SlimeSwarm() : speed(2.0f), animTimer(0.0f) {}
+
+    // 在可通行格子上随机生成count个NPC（与avoid格的BFS步数不小于minDistance，种子固定则结果固定）
+    void spawn(const CollisionMap& collision, const FlowField& field, int count, unsigned seed, int minDistance = 5);
+    void clear();
+
+    // 批量更新：沿流场转向→积分→碰撞（远离墙体的直接放行，其余走扫掠）
+    void update(const CollisionMap& collision, const FlowField& field, float deltaTime);
+
+    // 是否有NPC与点(x, y)的距离小于radius（像素）
+    bool anyWithin(float x, float y, float radius) const;
+
+    size_t size() const { return posX.size(); }
+    float getSpeed() const { return speed; }
+    void setSpeed(float value) { speed = value; }
+    float getAnimTimer() const { return animTimer; }
+
+    // SoA数组只读访问（渲染批量读取）
+    const std::vector<float>& getPosX() const { return posX; }
+    const std::vector<float>& getPosY() const { return posY; }
+    const std::vector<float>& getPrevPosX() const { return prevX; }
+    const std::vector<float>& getPrevPosY() const { return prevY; }
+    const std::vector<float>& getVelX() const { return velX; }
+    const std::vector<float>& getVelY() const { return velY; }
+    const std::vector<int>& getTiles() const { return tile; }
+    const std::vector<State>& getStates() const { return state; }
+
+private:
+    float speed;                // 移动速度（像素/逻辑帧@60Hz，与玩家同一单位）
+    float animTimer;            // 共享动画计时（各NPC按序号错开帧）
+
+    // SoA：每个NPC的属性分别存放在连续数组中
+    std::vector<float> posX, posY;    // 中心像素坐标
+    std::vector<float> prevX, prevY;  // 上一逻辑步坐标（渲染插值用）
+    std::vector<float> velX, velY;    // 速度（像素/秒）
+    std::vector<int> tile;            // 所在格子序号（row * cols + col）
+    std::vector<State> state;         // 状态
+
+    // 批处理临时数组（复用，避免每步分配）
+    std::vector<float> nextX, nextY;
+    std::vector<int> sweepList;       // 需要走扫掠碰撞的NPC序号
+};
+
+#endif // SLIME_SWARM_H
@@ -1,34 +1,41 @@
 #include "TextureManager.h"
 
-// 죺
+// 构造：加载所有纹理
 TextureManager::TextureManager(const std::unordered_map<BlockType, std::string>& texPaths) {
     for (const auto& pair : texPaths) {
         BlockType type = pair.first;
         const std::string& path = pair.second;
 
-        // 
+        // 加载纹理
         Texture2D tex = LoadTexture(path.c_str());
-        if (tex.id == 0) { // ʧ
+        if (tex.id == 0) { // 纹理加载失败
             throw std::runtime_error("Failed to load texture: " + path);
         }
 
-        textureMap[type] = tex;
+        textures[slotOf(type)] = tex;
     }
 }
 
-// ͷ
+// 构造：从异步加载器取走纹理（所有权转入本对象，析构时释放）
+TextureManager::TextureManager(const std::unordered_map<BlockType, std::string>& texPaths, AssetLoader& assets) {
+    for (const auto& pair : texPaths) {
+        textures[slotOf(pair.first)] = assets.takeTexture(pair.second);
+    }
+}
+
+// 析构：释放所有纹理
 TextureManager::~TextureManager() {
-    for (auto& pair : textureMap) {
-        UnloadTexture(pair.second);
+    for (Texture2D& tex : textures) {
+        if (tex.id != 0) UnloadTexture(tex);
+        tex = Texture2D{};
     }
-    textureMap.clear();
 }
 
-// ȡָؿ͵
-Texture2D TextureManager::getTexture(BlockType type) const {
-    auto it = textureMap.find(type);
-    if (it == textureMap.end()) {
+// 获取指定地块类型的纹理（定长数组下标，不查哈希表）
+const Texture2D& TextureManager::getTexture(BlockType type) const {
+    int slot = slotOf(type);
+    if (slot < 0 || slot >= SLOT_COUNT || textures[slot].id == 0) {
         throw std::runtime_error("No texture found for block type!");
     }
-    return it->second;
+    return textures[slot];
 }
\ No newline at end of file
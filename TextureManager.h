@@ -2,28 +2,35 @@
 #define TEXTURE_MANAGER_H
 #include "raylib.h"
 #include "MazeParser.h"
+#include "AssetLoader.h"
 #include <unordered_map>
 #include <string>
 #include <stdexcept>
 
-// ࣨװءӳ䡢ͷţ
+// 纹理管理类（封装纹理加载、映射、释放）
 class TextureManager {
 public:
-    // 죺·ӳ
+    // 构造：加载所有纹理（传入纹理路径映射表）
     TextureManager(const std::unordered_map<BlockType, std::string>& texPaths);
-    // ͷмص
+    // 构造：从异步加载器取走纹理（尚未就绪的会等待其解码上传）
+    TextureManager(const std::unordered_map<BlockType, std::string>& texPaths, AssetLoader& assets);
+    // 析构：释放所有加载的纹理
     ~TextureManager();
 
-    // ȡָؿ͵
-    Texture2D getTexture(BlockType type) const;
+    // 获取指定地块类型的纹理（返回引用，不拷贝；未加载的类型抛出异常）
+    const Texture2D& getTexture(BlockType type) const;
 
-    // ÿظͷţ
+    // 禁用拷贝（避免纹理重复释放）
     TextureManager(const TextureManager&) = delete;
     TextureManager& operator=(const TextureManager&) = delete;
 
 private:
-    // ؿ  ӳ
-    std::unordered_map<BlockType, Texture2D> textureMap;
+    // 地块类型的取值范围是END(-2)到LAVA(3)，按“类型 - END”直接下标
+    static const int SLOT_COUNT = static_cast<int>(BlockType::LAVA) - static_cast<int>(BlockType::END) + 1;
+    static int slotOf(BlockType type) { return static_cast<int>(type) - static_cast<int>(BlockType::END); }
+
+    // 地块类型 → 纹理（id为0表示该类型未加载）
+    Texture2D textures[SLOT_COUNT] = {};
 };
 
 #endif // TEXTURE_MANAGER_H
\ No newline at end of file
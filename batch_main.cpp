@@ -0,0 +1,331 @@
+#include "MazeParser.h"
+#include "PathFinder.h"
+#include "CellGrid.h"
+#include "ResumableSearch.h"
+#include "BoundedQueue.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+// 批量校验程序：把目录下的全部迷宫文件按流水线求解，逐行输出CSV结果
+// 用法：MazeBatch [--readers N] [--solvers N] [--queue N] [--out 文件] [--ext .txt,.bin] <目录或文件>...
+// 流水线：读取/解析线程（MazeParser） → 有界队列 → 求解线程（BFS、Dijkstra、熔岩1次） → 有界队列 → 写出线程
+// 队列深度限制了同时驻留内存的迷宫数：至多 readers + queue + solvers 张（解析后即转为每格1字节的网格）
+namespace {
+    typedef std::chrono::steady_clock Clock;
+
+    double elapsedMs(Clock::time_point begin, Clock::time_point end) {
+        return std::chrono::duration<double, std::milli>(end - begin).count();
+    }
+
+    struct BatchOptions {
+        int readers = 2;
+        int solvers = 1;
+        size_t queueDepth = 16;
+        std::string outPath;                                   // 为空时写到标准输出
+        std::vector<std::string> extensions = { ".txt", ".bin" };
+    };
+
+    // 解析阶段的产物：紧凑网格 + 起终点；解析失败时grid为空、error为原因
+    struct ParsedMaze {
+        size_t index = 0;
+        std::string path;
+        std::shared_ptr<const CellGrid> grid;
+        Point start;
+        Point end;
+        std::string error;
+        double parseMs = 0.0;
+    };
+
+    // 一种算法的求解结果（无路径时cost与length为-1）
+    struct AlgorithmResult {
+        int cost = -1;
+        int length = -1;
+        long long expanded = 0;
+    };
+
+    struct SolvedMaze {
+        size_t index = 0;
+        std::string path;
+        int rows = 0;
+        int cols = 0;
+        std::string error;
+        AlgorithmResult results[3];  // 依次为BFS、Dijkstra、熔岩1次
+        double parseMs = 0.0;
+        double solveMs = 0.0;
+    };
+
+    const SearchAlgorithm ALGORITHMS[3] = { SearchAlgorithm::BFS, SearchAlgorithm::DIJKSTRA, SearchAlgorithm::LAVA_ONCE };
+
+    bool hasExtension(const std::string& name, const std::vector<std::string>& extensions) {
+        for (const std::string& ext : extensions) {
+            if (name.size() >= ext.size() && name.compare(name.size() - ext.size(), ext.size(), ext) == 0) return true;
+        }
+        return false;
+    }
+
+    // 列出目录下（不递归）扩展名匹配的普通文件
+    void listDirectory(const std::string& dir, const std::vector<std::string>& extensions, std::vector<std::string>& out) {
+#ifdef _WIN32
+        WIN32_FIND_DATAA data;
+        HANDLE handle = FindFirstFileA((dir + "\\*").c_str(), &data);
+        if (handle == INVALID_HANDLE_VALUE) throw std::runtime_error("Failed to open directory: " + dir);
+        do {
+            if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) continue;
+            if (hasExtension(data.cFileName, extensions)) out.push_back(dir + "\\" + data.cFileName);
+        } while (FindNextFileA(handle, &data));
+        FindClose(handle);
+#else
+        DIR* handle = opendir(dir.c_str());
+        if (handle == nullptr) throw std::runtime_error("Failed to open directory: " + dir);
+        while (dirent* entry = readdir(handle)) {
+            std::string path = dir + "/" + entry->d_name;
+            struct stat info;
+            if (stat(path.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) continue;
+            if (hasExtension(entry->d_name, extensions)) out.push_back(path);
+        }
+        closedir(handle);
+#endif
+    }
+
+    bool isDirectory(const std::string& path) {
+#ifdef _WIN32
+        DWORD attributes = GetFileAttributesA(path.c_str());
+        return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY);
+#else
+        struct stat info;
+        return stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+#endif
+    }
+
+    // 按成本模型累计路径成本（熔岩1次模式下熔岩不计成本）
+    int pathCost(const CellGrid& grid, SearchAlgorithm algorithm, const std::vector<Point>& path) {
+        int cost = 0;
+        for (size_t i = 1; i < path.size(); ++i) {
+            BlockType block = grid.at(grid.index(path[i].row, path[i].col));
+            if (algorithm == SearchAlgorithm::BFS) cost += 1;
+            else if (algorithm != SearchAlgorithm::LAVA_ONCE || block != BlockType::LAVA) cost += PathFinder::tileCost(block);
+        }
+        return cost;
+    }
+
+    // CSV字段：含逗号、引号或换行时加引号
+    std::string csvField(const std::string& text) {
+        if (text.find_first_of(",\"\n") == std::string::npos) return text;
+        std::string quoted = "\"";
+        for (char c : text) {
+            if (c == '"') quoted += '"';
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+
+    // 各阶段累计耗时（所有线程之和，微秒）
+    struct StageTotals {
+        std::atomic<long long> parseUs{ 0 };
+        std::atomic<long long> solveUs{ 0 };
+        std::atomic<long long> writeUs{ 0 };
+        std::atomic<long long> cells{ 0 };
+        std::atomic<size_t> failed{ 0 };
+        std::atomic<size_t> unsolvable{ 0 };
+    };
+
+    void addUs(std::atomic<long long>& total, Clock::time_point begin, Clock::time_point end) {
+        total.fetch_add(std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count());
+    }
+
+    // 读取/解析：各线程从共享下标领取文件；最后一个退出的线程关闭下游队列
+    void readStage(const std::vector<std::string>& files, std::atomic<size_t>& nextFile, std::atomic<int>& activeReaders,
+        BoundedQueue<ParsedMaze>& parsed, StageTotals& totals) {
+        for (size_t i = nextFile.fetch_add(1); i < files.size(); i = nextFile.fetch_add(1)) {
+            ParsedMaze item;
+            item.index = i;
+            item.path = files[i];
+            auto begin = Clock::now();
+            try {
+                Maze maze = MazeParser::loadFromFile(files[i]);
+                PathFinder probe(maze); // 缺少起终点时在此抛出
+                item.start = probe.getStartPoint();
+                item.end = probe.getEndPoint();
+                item.grid = std::make_shared<const CellGrid>(maze, CellGrid::preferredLayout(maze));
+            }
+            catch (const std::exception& e) {
+                item.error = e.what();
+            }
+            auto end = Clock::now();
+            item.parseMs = elapsedMs(begin, end);
+            addUs(totals.parseUs, begin, end);
+            if (!parsed.push(std::move(item))) break;
+        }
+        if (activeReaders.fetch_sub(1) == 1) parsed.close();
+    }
+
+    // 求解：同一张网格依次跑三种算法
+    void solveStage(BoundedQueue<ParsedMaze>& parsed, std::atomic<int>& activeSolvers,
+        BoundedQueue<SolvedMaze>& solved, StageTotals& totals) {
+        ParsedMaze item;
+        while (parsed.pop(item)) {
+            SolvedMaze result;
+            result.index = item.index;
+            result.path = std::move(item.path);
+            result.error = std::move(item.error);
+            result.parseMs = item.parseMs;
+            if (item.grid) {
+                auto begin = Clock::now();
+                result.rows = item.grid->getRows();
+                result.cols = item.grid->getCols();
+                totals.cells.fetch_add(static_cast<long long>(result.rows) * result.cols);
+                try {
+                    for (int a = 0; a < 3; ++a) {
+                        ResumableSearch search(item.grid, ALGORITHMS[a], item.start, item.end);
+                        AlgorithmResult& out = result.results[a];
+                        if (search.run() == ResumableSearch::Status::FOUND) {
+                            std::vector<Point> path = search.getPath();
+                            out.length = static_cast<int>(path.size()) - 1;
+                            out.cost = pathCost(*item.grid, ALGORITHMS[a], path);
+                        }
+                        out.expanded = search.getExpandedCount();
+                    }
+                }
+                catch (const std::exception& e) {
+                    result.error = e.what();
+                }
+                auto end = Clock::now();
+                result.solveMs = elapsedMs(begin, end);
+                addUs(totals.solveUs, begin, end);
+                item.grid.reset();
+            }
+            if (!result.error.empty()) totals.failed.fetch_add(1);
+            else if (result.results[0].length < 0) totals.unsolvable.fetch_add(1);
+            if (!solved.push(std::move(result))) break;
+        }
+        if (activeSolvers.fetch_sub(1) == 1) solved.close();
+    }
+
+    // 写出：按完成顺序逐行输出（index列为输入顺序），每64行刷新一次
+    void writeStage(BoundedQueue<SolvedMaze>& solved, std::ostream& out, StageTotals& totals) {
+        out << "index,file,rows,cols,status,bfs_steps,dijkstra_cost,dijkstra_steps,lava_cost,lava_steps,"
+            "expanded,parse_ms,solve_ms,error\n";
+        SolvedMaze item;
+        size_t written = 0;
+        while (solved.pop(item)) {
+            auto begin = Clock::now();
+            const char* status = !item.error.empty() ? "error" : item.results[0].length < 0 ? "nopath" : "ok";
+            long long expanded = item.results[0].expanded + item.results[1].expanded + item.results[2].expanded;
+            out << item.index << ',' << csvField(item.path) << ',' << item.rows << ',' << item.cols << ',' << status
+                << ',' << item.results[0].length << ',' << item.results[1].cost << ',' << item.results[1].length
+                << ',' << item.results[2].cost << ',' << item.results[2].length << ',' << expanded
+                << ',' << item.parseMs << ',' << item.solveMs << ',' << csvField(item.error) << '\n';
+            if (++written % 64 == 0) out.flush();
+            addUs(totals.writeUs, begin, Clock::now());
+        }
+        out.flush();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        BatchOptions options;
+        options.solvers = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        std::vector<std::string> inputs;
+        for (int i = 1; i < argc; ++i) {
+            bool hasValue = i + 1 < argc;
+            if (hasValue && std::strcmp(argv[i], "--readers") == 0) options.readers = std::max(1, std::atoi(argv[++i]));
+            else if (hasValue && std::strcmp(argv[i], "--solvers") == 0) options.solvers = std::max(1, std::atoi(argv[++i]));
+            else if (hasValue && std::strcmp(argv[i], "--queue") == 0) options.queueDepth = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+            else if (hasValue && std::strcmp(argv[i], "--out") == 0) options.outPath = argv[++i];
+            else if (hasValue && std::strcmp(argv[i], "--ext") == 0) {
+                options.extensions.clear();
+                std::stringstream list(argv[++i]);
+                std::string ext;
+                while (std::getline(list, ext, ',')) {
+                    if (!ext.empty()) options.extensions.push_back(ext);
+                }
+            }
+            else inputs.push_back(argv[i]);
+        }
+        if (inputs.empty()) {
+            std::cerr << "usage: MazeBatch [--readers N] [--solvers N] [--queue N] [--out FILE] [--ext .txt,.bin]"
+                " <dir or file>...\n";
+            return -1;
+        }
+
+        // 目录按文件名排序展开，单独给出的文件原样保留
+        std::vector<std::string> files;
+        for (const std::string& input : inputs) {
+            if (!isDirectory(input)) {
+                files.push_back(input);
+                continue;
+            }
+            std::vector<std::string> listed;
+            listDirectory(input, options.extensions, listed);
+            std::sort(listed.begin(), listed.end());
+            files.insert(files.end(), listed.begin(), listed.end());
+        }
+
+        std::ofstream outFile;
+        if (!options.outPath.empty()) {
+            outFile.open(options.outPath);
+            if (!outFile.is_open()) throw std::runtime_error("Failed to open output file: " + options.outPath);
+        }
+        std::ostream& out = options.outPath.empty() ? std::cout : outFile;
+
+        BoundedQueue<ParsedMaze> parsed(options.queueDepth);
+        BoundedQueue<SolvedMaze> solved(options.queueDepth);
+        StageTotals totals;
+        std::atomic<size_t> nextFile(0);
+        std::atomic<int> activeReaders(options.readers);
+        std::atomic<int> activeSolvers(options.solvers);
+
+        auto begin = Clock::now();
+        std::vector<std::thread> threads;
+        for (int i = 0; i < options.readers; ++i) {
+            threads.emplace_back(readStage, std::cref(files), std::ref(nextFile), std::ref(activeReaders),
+                std::ref(parsed), std::ref(totals));
+        }
+        for (int i = 0; i < options.solvers; ++i) {
+            threads.emplace_back(solveStage, std::ref(parsed), std::ref(activeSolvers), std::ref(solved), std::ref(totals));
+        }
+        writeStage(solved, out, totals);
+        for (std::thread& thread : threads) thread.join();
+        const double wallMs = elapsedMs(begin, Clock::now());
+
+        // 汇总写到标准错误（标准输出留给CSV）。阶段耗时为各线程之和；
+        // 解析队列满等待多说明求解是瓶颈，空等待多说明读取/解析是瓶颈
+        std::cerr << "files=" << files.size() << " failed=" << totals.failed.load()
+            << " nopath=" << totals.unsolvable.load()
+            << " readers=" << options.readers << " solvers=" << options.solvers << " queue=" << options.queueDepth
+            << "\nwall=" << wallMs << "ms throughput=" << (wallMs > 0 ? files.size() * 1000.0 / wallMs : 0.0)
+            << " files/s " << (wallMs > 0 ? totals.cells.load() / wallMs / 1000.0 : 0.0) << " Mcells/s"
+            << "\nparse=" << totals.parseUs.load() / 1000.0 << "ms solve=" << totals.solveUs.load() / 1000.0
+            << "ms write=" << totals.writeUs.load() / 1000.0 << "ms (thread totals)"
+            << "\nparsed queue: peak=" << parsed.getPeakSize() << " full_waits=" << parsed.getFullWaits()
+            << " empty_waits=" << parsed.getEmptyWaits()
+            << "; solved queue: peak=" << solved.getPeakSize() << " full_waits=" << solved.getFullWaits()
+            << " empty_waits=" << solved.getEmptyWaits() << std::endl;
+        if (!out) throw std::runtime_error("Failed to write results");
+        return totals.failed.load() == 0 ? 0 : 1;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+}
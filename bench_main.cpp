@@ -0,0 +1,348 @@
+#include "MazeParser.h"
+#include "MazeGenerator.h"
+#include "PathFinder.h"
+#include "GameSession.h"
+#include "ResumableSearch.h"
+#include "FieldOfView.h"
+#include "KShortestPaths.h"
+#include "BenchHarness.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <map>
+#include <algorithm>
+
+// ================= 测试迷宫（固定种子的编织迷宫：少量回路 + 草地/熔岩） =================
+static Maze generateBenchMaze(int rows, int cols, unsigned seed) {
+    MazeGenOptions options;
+    options.rows = rows;
+    options.cols = cols;
+    options.style = MazeStyle::BRAIDED;
+    options.seed = seed;
+    options.braidRatio = 0.1;
+    options.grassDensity = 0.10;
+    options.lavaDensity = 0.01; // 熔岩较少，保证允许踩1次的路径大多存在
+    return MazeGenerator::generate(options);
+}
+
+// 解析逗号分隔的整数列表（如 "20,64,256"）
+static std::vector<int> parseSizes(const std::string& text) {
+    std::vector<int> sizes;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) sizes.push_back(std::atoi(item.c_str()));
+    }
+    return sizes;
+}
+
+// 解析逗号分隔的“行x列”列表（如 "256x16384,64x65536"）
+static std::vector<std::pair<int, int>> parseShapes(const std::string& text) {
+    std::vector<std::pair<int, int>> shapes;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        size_t x = item.find('x');
+        if (x != std::string::npos) shapes.push_back({ std::atoi(item.c_str()), std::atoi(item.c_str() + x + 1) });
+    }
+    return shapes;
+}
+
+// 基准选项
+struct BenchOptions {
+    size_t dfsLimit = 100;        // DFS枚举路径数上限
+    int dfsMaxSize = 32;          // DFS只在不超过该边长的迷宫上运行
+    int routeCount = 10;          // 备选路线（k条最短无环路线）的条数
+    double maxSeconds = 10.0;     // 单次调用的时间预算（秒）
+    // 各用例已测得的最大每格耗时（纳秒），用于按规模线性外推下一次耗时
+    std::map<std::string, double> nsPerCell;
+    // 因预算跳过的用例数与其中最大的外推耗时（秒），结束时汇总到stderr
+    int skippedCount = 0;
+    double maxSkippedSeconds = 0.0;
+};
+
+// 带时间预算的运行：规模从小到大排列，按已测最大每格耗时外推，预计超预算则跳过（JSON中记为skipped，并打印到stderr）
+// 返回本次结果（跳过时返回nullptr；指针在下一次运行前有效）
+template<typename Fn>
+static BenchResult* runBudgeted(BenchHarness& harness, BenchOptions& options, const std::string& name,
+    const Maze& maze, const std::string& mazeName, Fn fn, long long opsPerCall = 1) {
+    const double cells = static_cast<double>(maze.rows) * maze.cols;
+    double& perCell = options.nsPerCell[name];
+    const double estimatedSeconds = perCell * cells / 1e9;
+    if (estimatedSeconds > options.maxSeconds) {
+        std::cerr << "  skipped " << name << " on " << mazeName << ": estimated " << estimatedSeconds
+            << " s per call > --max-seconds " << options.maxSeconds << std::endl;
+        harness.skip(name, mazeName, maze.rows, maze.cols, estimatedSeconds);
+        ++options.skippedCount;
+        options.maxSkippedSeconds = std::max(options.maxSkippedSeconds, estimatedSeconds);
+        return nullptr;
+    }
+    BenchResult& result = harness.run(name, mazeName, maze.rows, maze.cols, fn, opsPerCall);
+    perCell = std::max(perCell, result.nsPerOp * opsPerCall / cells);
+    return &result;
+}
+
+// 把搜索统计追加到结果指标
+static void appendSearchStats(BenchResult& result, const SearchStats& stats) {
+    result.metrics.push_back({ "nodes_expanded", static_cast<double>(stats.nodesExpanded) });
+    result.metrics.push_back({ "nodes_pushed", static_cast<double>(stats.nodesPushed) });
+    result.metrics.push_back({ "stale_pops", static_cast<double>(stats.stalePops) });
+    result.metrics.push_back({ "peak_frontier", static_cast<double>(stats.peakFrontier) });
+    result.metrics.push_back({ "search_bytes", static_cast<double>(stats.bytesAllocated) });
+}
+
+// 对一个迷宫运行全部PathFinder用例
+static void benchPathFinder(BenchHarness& harness, BenchOptions& options, const Maze& maze, const std::string& mazeName) {
+    PathFinder pathFinder(maze);
+
+    // 运行一次搜索并记录路径长度；无路径时记录found=0
+    auto search = [&](BenchResult& result, std::vector<Point>(PathFinder::* method)()) {
+        try {
+            std::vector<Point> path = (pathFinder.*method)();
+            result.metrics = { {"found", 1}, {"path_length", static_cast<double>(path.size())} };
+        }
+        catch (const std::runtime_error&) {
+            result.metrics = { {"found", 0} };
+        }
+    };
+
+    // 计时用不带统计的接口；计时结束后再跑一次带统计的接口，把计数追加到指标
+    typedef std::vector<Point>(PathFinder::* CountedSearch)(SearchStats&);
+    auto searchCase = [&](const std::string& name, std::vector<Point>(PathFinder::* method)(), CountedSearch counted) {
+        BenchResult* result = runBudgeted(harness, options, name, maze, mazeName,
+            [&](BenchResult& r) { search(r, method); });
+        if (result == nullptr) return;
+        SearchStats stats;
+        try {
+            (pathFinder.*counted)(stats);
+        }
+        catch (const std::runtime_error&) {
+        }
+        appendSearchStats(*result, stats);
+    };
+
+    searchCase("bfs", &PathFinder::findShortestPathByBFS, &PathFinder::findShortestPathByBFS);
+    searchCase("dijkstra", &PathFinder::findShortestPathByDijkstra, &PathFinder::findShortestPathByDijkstra);
+    searchCase("lava_once", &PathFinder::findShortestPathWithOneLava, &PathFinder::findShortestPathWithOneLava);
+
+    // DFS枚举路径数随规模指数增长，只在小迷宫上带上限运行
+    if (maze.rows <= options.dfsMaxSize && maze.cols <= options.dfsMaxSize) {
+        BenchResult* result = runBudgeted(harness, options, "dfs_limit_" + std::to_string(options.dfsLimit), maze, mazeName,
+            [&](BenchResult& r) {
+                try {
+                    auto paths = pathFinder.findAllPathsByDFS(options.dfsLimit);
+                    r.metrics = { {"found", 1}, {"paths", static_cast<double>(paths.size())} };
+                }
+                catch (const std::runtime_error&) {
+                    r.metrics = { {"found", 0} };
+                }
+            });
+        if (result != nullptr) {
+            SearchStats stats;
+            try {
+                pathFinder.findAllPathsByDFS(stats, options.dfsLimit);
+            }
+            catch (const std::runtime_error&) {
+            }
+            appendSearchStats(*result, stats);
+        }
+    }
+}
+
+// 扁平搜索引擎（ResumableSearch一次跑完）在两种地块布局下的对比：路径相同，差别只在访存局部性。
+// 网格在计时外建立，计时只包含搜索（状态数组的分配与初始化也按布局进行）
+static void benchCellLayout(BenchHarness& harness, BenchOptions& options, const Maze& maze, const std::string& mazeName) {
+    PathFinder probe(maze);
+    const Point start = probe.getStartPoint(), goal = probe.getEndPoint();
+    const struct { CellLayout layout; const char* name; } layouts[] = {
+        { CellLayout::ROW_MAJOR, "row_major" }, { CellLayout::TILED, "tiled" } };
+    const struct { SearchAlgorithm algorithm; const char* name; } algorithms[] = {
+        { SearchAlgorithm::BFS, "flat_bfs" }, { SearchAlgorithm::DIJKSTRA, "flat_dijkstra" } };
+    for (const auto& algorithm : algorithms) {
+        for (const auto& layout : layouts) {
+            auto grid = std::make_shared<const CellGrid>(maze, layout.layout);
+            runBudgeted(harness, options, std::string(algorithm.name) + "_" + layout.name, maze, mazeName, [&](BenchResult& r) {
+                ResumableSearch search(grid, algorithm.algorithm, start, goal);
+                bool found = search.run() == ResumableSearch::Status::FOUND;
+                r.metrics = { {"found", found ? 1.0 : 0.0},
+                    {"path_length", static_cast<double>(search.getPath().size())},
+                    {"nodes_expanded", static_cast<double>(search.getExpandedCount())} };
+            });
+        }
+    }
+}
+
+// 备选路线：起点→终点的前routeCount条Dijkstra无环路线（代替DFS穷举的用途，可在任意规模上运行）。
+// 引擎在计时外建立；每次调用新建KShortestPaths，计时包含终点最短路树
+static void benchRoutes(BenchHarness& harness, BenchOptions& options, const Maze& maze, const std::string& mazeName) {
+    PathQueryEngine engine(maze, 0);
+    RouteOptions routeOptions;
+    routeOptions.count = options.routeCount;
+    std::vector<RankedRoute> routes;
+    runBudgeted(harness, options, "k_shortest_" + std::to_string(options.routeCount), maze, mazeName, [&](BenchResult& r) {
+        KShortestPaths finder(engine);
+        finder.find(engine.getStartPoint(), engine.getEndPoint(), routeOptions, routes);
+        const KShortestPaths::Stats& stats = finder.getLastStats();
+        r.metrics = { {"routes", static_cast<double>(routes.size())},
+            {"worst_cost", routes.empty() ? 0.0 : static_cast<double>(routes.back().cost)},
+            {"spur_searches", static_cast<double>(stats.spurSearches)},
+            {"tree_joins", static_cast<double>(stats.treeJoins)},
+            {"nodes_expanded", static_cast<double>(stats.expanded)},
+            {"tree_ms", stats.treeMs} };
+    });
+}
+
+// 加载迷宫文件
+static void benchParse(BenchHarness& harness, BenchOptions& options, const std::string& filePath, const std::string& mazeName) {
+    Maze probe = MazeParser::loadFromFile(filePath);
+    runBudgeted(harness, options, "parse", probe, mazeName, [&](BenchResult& r) {
+        Maze maze = MazeParser::loadFromFile(filePath);
+        r.metrics = { {"cells", static_cast<double>(maze.rows) * maze.cols} };
+    });
+}
+
+// 无头玩家更新：固定脚本输入（每30步顺时针换方向），每次调用推进STEPS个逻辑步
+// （对局在计时外构造，计时只包含逻辑步；碰到终点/失败时重置后继续）
+static void benchPlayerUpdate(BenchHarness& harness, BenchOptions& options, const Maze& maze, const std::string& mazeName) {
+    const int STEPS = 1000;
+    GameSession session(maze);
+    InputState input;
+    input.start = true;
+    session.handleInput(input);
+    input.start = false;
+    InputState resetInput;
+    resetInput.reset = true;
+    long long step = 0;
+
+    runBudgeted(harness, options, "player_update", maze, mazeName, [&](BenchResult& r) {
+        for (int i = 0; i < STEPS; ++i, ++step) {
+            int dir = static_cast<int>(step / 30) % 4;
+            input.right = dir == 0;
+            input.down = dir == 1;
+            input.left = dir == 2;
+            input.up = dir == 3;
+            if (session.getState() != GameState::PLAYING) {
+                session.handleInput(resetInput);
+            }
+            session.update(input, GameSession::FIXED_STEP);
+        }
+        r.metrics = { {"steps", static_cast<double>(STEPS)} };
+    }, STEPS);
+}
+
+// 战争迷雾视野：沿起点到终点的BFS路径逐格移动观察者，每次调用把整条路径走一遍（每格重算一次视野）
+static void benchFieldOfView(BenchHarness& harness, BenchOptions& options, const Maze& maze, const std::string& mazeName) {
+    PathFinder probe(maze);
+    ResumableSearch search(maze, SearchAlgorithm::BFS, probe.getStartPoint(), probe.getEndPoint());
+    search.run();
+    const std::vector<Point> path = search.getPath();
+    if (path.empty()) return;
+    FieldOfView fov(maze);
+    runBudgeted(harness, options, "fov_walk", maze, mazeName, [&](BenchResult& r) {
+        size_t visible = 0;
+        for (const Point& p : path) {
+            fov.update(p);
+            visible += fov.getVisibleCount();
+        }
+        r.metrics = { {"updates", static_cast<double>(path.size())},
+            {"avg_visible", static_cast<double>(visible) / path.size()} };
+    }, static_cast<long long>(path.size()));
+}
+
+// 基准程序：计时PathFinder各算法、扁平搜索的地块布局对比、备选路线、迷宫解析、无头玩家更新和视野重算，输出JSON
+// 用法：MazeBench [--sizes 20,64,256,1024,4096] [--wide 256x16384] [--min-time 秒] [--max-seconds 秒]
+//                 [--dfs-limit N] [--dfs-max-size N] [--routes N] [--out 文件] [迷宫文件...]
+// 按外推耗时超出--max-seconds（默认10秒）而跳过的用例逐条打印到stderr，结束时给出能全部跑完所需的预算
+int main(int argc, char* argv[]) {
+    try {
+        std::vector<int> sizes = { 20, 64, 256, 1024, 4096 };
+        std::vector<std::pair<int, int>> wideShapes = { { 256, 16384 } };
+        std::vector<std::string> mazeFiles;
+        std::string outPath;
+        double minTime = 0.2;
+        BenchOptions options;
+
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--sizes") == 0 && i + 1 < argc) sizes = parseSizes(argv[++i]);
+            else if (std::strcmp(argv[i], "--wide") == 0 && i + 1 < argc) wideShapes = parseShapes(argv[++i]);
+            else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) minTime = std::atof(argv[++i]);
+            else if (std::strcmp(argv[i], "--max-seconds") == 0 && i + 1 < argc) options.maxSeconds = std::atof(argv[++i]);
+            else if (std::strcmp(argv[i], "--dfs-limit") == 0 && i + 1 < argc) options.dfsLimit = std::strtoul(argv[++i], nullptr, 10);
+            else if (std::strcmp(argv[i], "--dfs-max-size") == 0 && i + 1 < argc) options.dfsMaxSize = std::atoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--routes") == 0 && i + 1 < argc) options.routeCount = std::atoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) outPath = argv[++i];
+            else mazeFiles.push_back(argv[i]);
+        }
+        if (mazeFiles.empty()) {
+            mazeFiles = { "./maze0.txt", "./maze1.txt" };
+        }
+
+        BenchHarness harness(minTime);
+
+        // 1. 手工迷宫文件
+        for (const std::string& file : mazeFiles) {
+            std::cerr << "bench " << file << std::endl;
+            Maze maze = MazeParser::loadFromFile(file);
+            benchParse(harness, options, file, file);
+            benchPathFinder(harness, options, maze, file);
+            benchCellLayout(harness, options, maze, file);
+            benchRoutes(harness, options, maze, file);
+            benchPlayerUpdate(harness, options, maze, file);
+            benchFieldOfView(harness, options, maze, file);
+        }
+
+        // 2. 生成迷宫（从小到大，写出临时文件用于解析基准）
+        std::sort(sizes.begin(), sizes.end());
+        for (int size : sizes) {
+            std::string name = "generated_" + std::to_string(size) + "x" + std::to_string(size);
+            std::cerr << "bench " << name << std::endl;
+            Maze maze = generateBenchMaze(size, size, 12345u + size);
+            std::string tempFile = "./bench_" + name + ".txt";
+            MazeParser::saveToFile(maze, tempFile);
+            benchParse(harness, options, tempFile, name);
+            std::remove(tempFile.c_str());
+            benchPathFinder(harness, options, maze, name);
+            benchCellLayout(harness, options, maze, name);
+            benchRoutes(harness, options, maze, name);
+            benchPlayerUpdate(harness, options, maze, name);
+            benchFieldOfView(harness, options, maze, name);
+        }
+
+        // 3. 宽迷宫：只比较地块布局（行主序下上下邻格相隔一整行，列数越多越不友好）
+        for (const auto& shape : wideShapes) {
+            std::string name = "generated_" + std::to_string(shape.first) + "x" + std::to_string(shape.second);
+            std::cerr << "bench " << name << std::endl;
+            Maze maze = generateBenchMaze(shape.first, shape.second, 12345u + shape.second);
+            benchCellLayout(harness, options, maze, name);
+            benchRoutes(harness, options, maze, name);
+        }
+
+        if (options.skippedCount > 0) {
+            std::cerr << options.skippedCount << " case(s) skipped by the time budget; rerun with --max-seconds "
+                << static_cast<int>(std::ceil(options.maxSkippedSeconds)) << " to include them" << std::endl;
+        }
+
+        if (outPath.empty()) {
+            harness.writeJson(std::cout);
+        }
+        else {
+            std::ofstream out(outPath);
+            if (!out.is_open()) {
+                throw std::runtime_error("Failed to open output file: " + outPath);
+            }
+            harness.writeJson(out);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
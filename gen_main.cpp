@@ -0,0 +1,55 @@
+#include "MazeGenerator.h"
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+
+// 迷宫生成程序：按参数生成迷宫并写出文本或二进制文件（用于大规模寻路/模拟负载）
+// 用法：MazeGen <行数> <列数> <输出文件> [--style perfect|braided|cavern] [--seed N]
+//       [--braid 比例] [--fill 比例] [--grass 密度] [--lava 密度] [--region 分区边长] [--threads N] [--binary]
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 4) {
+            std::cerr << "usage: MazeGen <rows> <cols> <out> [--style perfect|braided|cavern] [--seed N]"
+                " [--braid R] [--fill R] [--grass D] [--lava D] [--region N] [--threads N] [--binary]\n";
+            return -1;
+        }
+
+        MazeGenOptions options;
+        options.rows = std::atoi(argv[1]);
+        options.cols = std::atoi(argv[2]);
+        const std::string outPath = argv[3];
+        bool binary = false;
+        for (int i = 4; i < argc; ++i) {
+            bool hasValue = i + 1 < argc;
+            if (std::strcmp(argv[i], "--binary") == 0) binary = true;
+            else if (hasValue && std::strcmp(argv[i], "--style") == 0) options.style = MazeGenerator::parseStyle(argv[++i]);
+            else if (hasValue && std::strcmp(argv[i], "--seed") == 0) options.seed = static_cast<unsigned>(std::atoi(argv[++i]));
+            else if (hasValue && std::strcmp(argv[i], "--braid") == 0) options.braidRatio = std::atof(argv[++i]);
+            else if (hasValue && std::strcmp(argv[i], "--fill") == 0) options.cavernFill = std::atof(argv[++i]);
+            else if (hasValue && std::strcmp(argv[i], "--grass") == 0) options.grassDensity = std::atof(argv[++i]);
+            else if (hasValue && std::strcmp(argv[i], "--lava") == 0) options.lavaDensity = std::atof(argv[++i]);
+            else if (hasValue && std::strcmp(argv[i], "--region") == 0) options.regionSize = std::atoi(argv[++i]);
+            else if (hasValue && std::strcmp(argv[i], "--threads") == 0) options.threadCount = std::atoi(argv[++i]);
+            else throw std::runtime_error(std::string("Unknown argument: ") + argv[i]);
+        }
+
+        auto begin = std::chrono::steady_clock::now();
+        Maze maze = MazeGenerator::generate(options);
+        auto generated = std::chrono::steady_clock::now();
+        if (binary) MazeParser::saveBinaryFile(maze, outPath);
+        else MazeParser::saveToFile(maze, outPath);
+        auto written = std::chrono::steady_clock::now();
+
+        std::cout << "maze=" << maze.rows << "x" << maze.cols
+            << " generate=" << std::chrono::duration<double, std::milli>(generated - begin).count() << "ms"
+            << " write=" << std::chrono::duration<double, std::milli>(written - generated).count() << "ms\n";
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
@@ -1,30 +1,102 @@
 #include "MazeParser.h"
 #include "TextureManager.h"
 #include "GameManager.h"
+#include "InputLog.h"
+#include "Profiler.h"
+#include "AllocTracker.h"
+#include "AssetLoader.h"
 #include "raylib.h"
 #include <iostream>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
 
-int main() {
+// 输出回放耗时摘要（平均/最大/P95）
+static void reportFrameTimings(const std::vector<GameManager::FrameTiming>& timings) {
+    if (timings.empty()) return;
+    std::vector<double> updates, draws;
+    for (const auto& t : timings) {
+        updates.push_back(t.updateMs);
+        draws.push_back(t.drawMs);
+    }
+    auto summarize = [](const char* name, std::vector<double>& values) {
+        double sum = 0.0;
+        for (double v : values) sum += v;
+        std::sort(values.begin(), values.end());
+        double p95 = values[static_cast<size_t>((values.size() - 1) * 0.95)];
+        TraceLog(LOG_INFO, "%s: avg=%.4fms p95=%.4fms max=%.4fms", name, sum / values.size(), p95, values.back());
+    };
+    TraceLog(LOG_INFO, "Replay frames: %d", static_cast<int>(timings.size()));
+    summarize("update", updates);
+    summarize("draw", draws);
+}
+
+// 命令行参数：
+//   --record <文件>   录制本局输入到日志
+//   --replay <文件>   回放输入日志
+//   --fast           回放时不限帧率，按日志帧间隔尽可能快地推进
+//   --timings <文件>  回放结束后输出逐帧耗时CSV
+//   --slimes <数量>   生成追踪玩家的史莱姆（默认不生成）
+//   --profile-csv <文件>  开启帧剖析，退出时输出各区段耗时CSV
+//   --path-slice <微秒>   寻路不使用工作线程，改为每帧在该预算内分帧推进
+//   --trace <文件>        开启帧剖析，退出时输出Chrome trace（chrome://tracing打开）
+//   --serial-assets      在主线程串行加载全部纹理后再显示首帧（对比启动耗时用）
+//   --no-asset-cache     不使用已解码像素缓存（resource/*.rawcache），每次都解码PNG
+//   --level <文件>        关卡文件（可重复指定，按顺序游玩；默认maze0.txt、maze1.txt）
+//   --watch              热重载：当前关卡文件保存后自动重新加载
+//   --fog                开局即开启战争迷雾（游戏中按F切换）
+//   运行中按F3显示/隐藏剖析叠加图，按H显示/隐藏通往终点的提示路径
+int main(int argc, char* argv[]) {
+    // 启动计时起点：启动指标（首帧耗时、全部资源就绪耗时）均相对于此
+    const auto launchTime = std::chrono::steady_clock::now();
+    auto msSinceLaunch = [launchTime]() {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - launchTime).count();
+    };
     try {
-        // =================  =================
+        std::string recordPath, replayPath, timingsPath, profileCsvPath, tracePath;
+        bool fastForward = false;
+        bool serialAssets = false;
+        bool useAssetCache = true;
+        bool hotReload = false;
+        bool fogOfWar = false;
+        std::vector<std::string> levelPaths;
+        int slimeCount = 0;
+        double pathSliceUs = 0.0;
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) recordPath = argv[++i];
+            else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) replayPath = argv[++i];
+            else if (std::strcmp(argv[i], "--timings") == 0 && i + 1 < argc) timingsPath = argv[++i];
+            else if (std::strcmp(argv[i], "--slimes") == 0 && i + 1 < argc) slimeCount = std::atoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--profile-csv") == 0 && i + 1 < argc) profileCsvPath = argv[++i];
+            else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) tracePath = argv[++i];
+            else if (std::strcmp(argv[i], "--path-slice") == 0 && i + 1 < argc) pathSliceUs = std::atof(argv[++i]);
+            else if (std::strcmp(argv[i], "--fast") == 0) fastForward = true;
+            else if (std::strcmp(argv[i], "--serial-assets") == 0) serialAssets = true;
+            else if (std::strcmp(argv[i], "--no-asset-cache") == 0) useAssetCache = false;
+            else if (std::strcmp(argv[i], "--level") == 0 && i + 1 < argc) levelPaths.push_back(argv[++i]);
+            else if (std::strcmp(argv[i], "--watch") == 0) hotReload = true;
+            else if (std::strcmp(argv[i], "--fog") == 0) fogOfWar = true;
+        }
+        Profiler::setEnabled(!profileCsvPath.empty() || !tracePath.empty());
+
+        // ================= 基础配置 =================
         const int WINDOW_WIDTH = 640;
         const int WINDOW_HEIGHT = 640;
-        const std::string MAZE_FILE = "./maze0.txt";
-        // С·
+        if (levelPaths.empty()) {
+            levelPaths = { "./maze0.txt", "./maze1.txt" };
+        }
+        // 新小人纹理路径
         const std::string PLAYER_TEX_PATH = "./resource/character.png";
 
-        // ================= ʼ =================
+        // ================= 初始化窗口 =================
         InitWindow(WINDOW_WIDTH, WINDOW_HEIGHT, "Maze Game - Full Task");
-        SetTargetFPS(60);
+        // 快进回放：不限帧率，逻辑仍按日志帧间隔推进
+        SetTargetFPS(fastForward && !replayPath.empty() ? 0 : 60);
 
-        // ================= Թ =================
-        Maze maze = MazeParser::loadFromFile(MAZE_FILE);
-        if (maze.rows != 20 || maze.cols != 20) {
-            throw std::runtime_error("Maze must be 2020 (task requirement)!");
-        }
-
-        // ================= · =================
-        std::unordered_map<BlockType, std::string> texPaths = {
+        // ================= 提交纹理解码 =================
+        // 开始界面背景图最先提交，其余纹理在工作线程上并行解码，首帧只需等待背景图
+        const std::unordered_map<BlockType, std::string> texPaths = {
             {BlockType::WALL,    "./resource/wall.png"},
             {BlockType::START,   "./resource/start.png"},
             {BlockType::GROUND,  "./resource/floor.png"},
@@ -32,21 +104,93 @@ int main() {
             {BlockType::GRASS,   "./resource/grass.png"},
             {BlockType::LAVA,    "./resource/lava.png"}
         };
+        const int decodeThreads = serialAssets ? 0 : AssetLoader::defaultThreadCount();
+        AssetLoader assets(decodeThreads, useAssetCache);
+        assets.request(GameManager::START_BG_PATH);
+        for (const auto& pair : texPaths) {
+            assets.request(pair.second);
+        }
+        assets.request(PLAYER_TEX_PATH);
+        assets.request(GameManager::SLIME_TEX_PATH);
 
-        // =================  =================
-        TextureManager texManager(texPaths);
+        // ================= 加载阶段：先显示开始界面，每帧上传已解码完成的纹理 =================
+        const Texture2D loadingBg = assets.getTexture(GameManager::START_BG_PATH);
+        double firstFrameMs = -1.0;
+        while (!assets.allDone() && !WindowShouldClose()) {
+            assets.uploadReady();
+            BeginDrawing();
+            ClearBackground(RAYWHITE);
+            GameManager::drawStartScreen(loadingBg, TextFormat("Loading... %d/%d",
+                static_cast<int>(assets.getDoneCount()), static_cast<int>(assets.getRequestedCount())));
+            EndDrawing();
+            if (firstFrameMs < 0.0) firstFrameMs = msSinceLaunch();
+        }
 
-        // ================= ʼϷС· =================
-        GameManager gameManager(maze, texManager, PLAYER_TEX_PATH);
+        // ================= 加载纹理 =================
+        TextureManager texManager(texPaths, assets);
 
-        // ================= ѭ =================
+        // ================= 初始化游戏管理器：加载第一关，后台预加载下一关 =================
+        // 每一关都须是20×20（GameManager::LEVEL_ROWS/LEVEL_COLS），第一关不符时在这里抛出异常，
+        // 预加载的关卡不符时在切关前由GameManager::update抛出，同样走下面的错误处理
+        GameManager gameManager(levelPaths, texManager, assets, PLAYER_TEX_PATH, slimeCount, pathSliceUs);
+        gameManager.setHotReload(hotReload);
+        gameManager.setFogOfWar(fogOfWar);
+        const double assetsReadyMs = msSinceLaunch();
+
+        // ================= 录制/回放 =================
+        InputLog replayLog;
+        if (!replayPath.empty()) {
+            replayLog = InputLog::loadFromFile(replayPath);
+            gameManager.startReplay(replayLog);
+        }
+        else if (!recordPath.empty()) {
+            gameManager.startRecording();
+        }
+
+        // ================= 主循环 =================
         while (!WindowShouldClose()) {
+            Profiler::beginFrame();
             gameManager.handleInput();
             gameManager.update(GetFrameTime());
             gameManager.draw();
+            // 串行加载时没有加载帧，首帧就是主循环的第一帧
+            if (firstFrameMs < 0.0) firstFrameMs = msSinceLaunch();
+            if (gameManager.isReplayFinished()) break;
+        }
+        if (AllocTracker::isHooked()) {
+            const FrameAllocCounter& allocs = gameManager.getFrameAllocs();
+            TraceLog(LOG_INFO, "Allocations: %d of %d frames allocated (max %d per frame)",
+                static_cast<int>(allocs.getAllocatingFrames()), static_cast<int>(allocs.getFrameCount()),
+                static_cast<int>(allocs.getMaxFrameAllocations()));
+        }
+        if (firstFrameMs >= 0.0) {
+            TraceLog(LOG_INFO, "Startup: first frame %.1f ms, all textures ready %.1f ms (%d decode threads, %d/%d from cache)",
+                firstFrameMs, assetsReadyMs, decodeThreads, assets.getCacheHitCount(), static_cast<int>(assets.getRequestedCount()));
+        }
+
+        // ================= 保存录制/输出回放耗时 =================
+        if (!recordPath.empty() && replayPath.empty()) {
+            gameManager.getRecording().saveToFile(recordPath);
+            TraceLog(LOG_INFO, "Recorded %d frames to %s", static_cast<int>(gameManager.getRecording().size()), recordPath.c_str());
+        }
+        if (gameManager.isReplaying()) {
+            reportFrameTimings(gameManager.getFrameTimings());
+            if (!timingsPath.empty()) {
+                gameManager.writeFrameTimings(timingsPath);
+            }
+        }
+
+        // ================= 输出剖析数据（缓冲只保留最近的事件） =================
+        if (!profileCsvPath.empty()) {
+            Profiler::writeCsv(profileCsvPath);
+            TraceLog(LOG_INFO, "Profile CSV written to %s", profileCsvPath.c_str());
+        }
+        if (!tracePath.empty()) {
+            Profiler::writeChromeTrace(tracePath);
+            TraceLog(LOG_INFO, "Chrome trace written to %s", tracePath.c_str());
         }
 
-        // ================= Դͷ =================
+        // ================= 资源释放 =================
         CloseWindow();
     }
     catch (const std::exception& e) {
@@ -0,0 +1,534 @@
+#include "MazeParser.h"
+#include "PathQueryEngine.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <set>
+#include <map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <future>
+#include <chrono>
+#include <algorithm>
+#include <csignal>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+namespace {
+    typedef std::chrono::steady_clock Clock;
+
+    std::atomic<bool> stopRequested(false);
+    void onSignal(int) { stopRequested.store(true); }
+
+    // 读取；被信号打断且已请求停止时按EOF处理
+    long readFd(int fd, char* buffer, size_t size) {
+        while (true) {
+#ifdef _WIN32
+            long n = _read(fd, buffer, static_cast<unsigned>(size));
+#else
+            long n = static_cast<long>(::read(fd, buffer, size));
+#endif
+            if (n >= 0) return n;
+            if (errno != EINTR || stopRequested.load()) return 0;
+        }
+    }
+
+    // 写完整个缓冲；对端已关闭时返回false
+    bool writeAll(int fd, const std::string& data) {
+        size_t done = 0;
+        while (done < data.size()) {
+#ifdef _WIN32
+            long n = _write(fd, data.data() + done, static_cast<unsigned>(data.size() - done));
+#else
+            long n = static_cast<long>(::write(fd, data.data() + done, data.size() - done));
+#endif
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            done += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    // 按空白切分一行（最多maxTokens个）
+    size_t splitTokens(const std::string& line, std::string* tokens, size_t maxTokens) {
+        size_t count = 0, pos = 0;
+        while (count < maxTokens) {
+            pos = line.find_first_not_of(" \t\r", pos);
+            if (pos == std::string::npos) break;
+            size_t end = line.find_first_of(" \t\r", pos);
+            tokens[count++] = line.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+            if (end == std::string::npos) break;
+            pos = end;
+        }
+        return count;
+    }
+
+    int parseInt(const std::string& token, const char* what) {
+        char* end = nullptr;
+        long value = std::strtol(token.c_str(), &end, 10);
+        if (token.empty() || *end != '\0') throw std::runtime_error(std::string("Bad ") + what + ": " + token);
+        return static_cast<int>(value);
+    }
+
+    // 已排序样本的分位数
+    double percentile(const std::vector<double>& sorted, double q) {
+        if (sorted.empty()) return 0.0;
+        return sorted[static_cast<size_t>((sorted.size() - 1) * q)];
+    }
+
+    struct ServerOptions {
+        int threads = 1;
+        size_t batchSize = 32;        // 一批最多的查询数（同一次读到的行按此切成若干批，分给不同工作线程）
+        size_t maxInflight = 256;     // 每个连接最多的未回复批数（超过时暂停读取，形成背压）
+        bool printPath = true;
+        int landmarks = PathQueryEngine::DEFAULT_LANDMARKS; // 每种成本模型的地标数（0为不建）
+        std::string socketPath;
+    };
+
+    // 一批查询：读取线程创建，工作线程填写回复，写出线程按顺序发送
+    struct Batch {
+        std::vector<std::string> lines;
+        std::vector<std::string> replies;
+        std::vector<double> solveUs;
+        std::vector<char> searched;   // 该查询跑了A*（否则由最短路树、地标区间直接给出或在检查时被拒绝）
+        Clock::time_point received;
+        bool done = false;            // 受所属连接的mutex保护
+    };
+
+    // 一个连接（或标准输入输出）的顺序回复队列
+    struct Connection {
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::deque<std::shared_ptr<Batch>> pending;   // 按收到的顺序，写出线程只发送队首已完成的批
+        bool inputClosed = false;
+    };
+}
+
+// 查询服务：常驻的各迷宫引擎 + 工作线程池 + 延迟统计。
+// 协议（每行一个查询，回复顺序与查询顺序一致）：
+//   <id> <迷宫> <起点行> <起点列> <终点行> <终点列> [bfs|dijkstra|lava] [熔岩预算]
+//   <id> <迷宫> <起点行> <起点列> <终点行> <终点列> bounds [bfs|dijkstra|lava]
+//   迷宫为序号（从0开始）或启动时给出的文件名；算法默认dijkstra；lava为熔岩预算查询（熔岩不计成本，预算默认1）；
+//   bounds不搜索，只按地标给出成本区间
+// 回复：<id> ok <成本> <熔岩格数> <路径格数> [行,列 ...] / <id> bounds <下界> <上界（未知时为-）>
+//       / <id> nopath / <id> error <原因>
+// 延迟：只有不搜索的查询能稳定做到p99 < 1ms——起点是迷宫START或终点是END的bfs/dijkstra查询（沿常驻最短路树回溯）、
+//   bounds、不同连通分量的nopath；任意点对与lava查询要跑A*，耗时随迷宫规模和路线长度增长。
+//   1001×1001编织迷宫、单工作线程、默认8个地标的实测求解耗时：树回溯p99约0.28ms；任意点对bfs/dijkstra的A*
+//   p50约2.3ms、p99约16ms（地标加到16个p99仍约16ms）；lava的A* p99约130ms。
+//   关闭时的统计把求解耗时按tree/astar两类分别给出
+class QueryServer {
+public:
+    QueryServer(const std::vector<std::string>& mazeNames, std::vector<std::unique_ptr<PathQueryEngine>> engines,
+        const ServerOptions& options)
+        : mazeNames(mazeNames), engines(std::move(engines)), options(options), stopping(false),
+        requestCount(0), errorCount(0), noPathCount(0) {
+        for (int i = 0; i < options.threads; ++i) {
+            workers.emplace_back(&QueryServer::workerLoop, this);
+        }
+    }
+
+    ~QueryServer() {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            stopping = true;
+        }
+        queueReady.notify_all();
+        for (auto& worker : workers) worker.join();
+    }
+
+    // 服务一个连接直到输入结束：当前线程读取并切批，另一线程按顺序写回
+    void serve(int inFd, int outFd) {
+        Connection connection;
+        std::vector<double> latencies, solves, treeSolves, searchSolves;
+        Clock::time_point first = Clock::time_point::max(), last = Clock::time_point::min();
+        std::thread writer([&]() {
+            std::string out;
+            bool outputOpen = true;
+            while (true) {
+                std::shared_ptr<Batch> batch;
+                {
+                    std::unique_lock<std::mutex> lock(connection.mutex);
+                    connection.changed.wait(lock, [&] {
+                        return (!connection.pending.empty() && connection.pending.front()->done)
+                            || (connection.inputClosed && connection.pending.empty());
+                    });
+                    if (connection.pending.empty()) break;
+                    batch = connection.pending.front();
+                    connection.pending.pop_front();
+                }
+                connection.changed.notify_all(); // 唤醒可能因背压等待的读取
+                out.clear();
+                for (const std::string& reply : batch->replies) {
+                    out += reply;
+                    out += '\n';
+                }
+                // 对端已关闭时继续取走完成的批（不再写出），读取一侧不会因背压卡住
+                if (outputOpen) outputOpen = writeAll(outFd, out);
+                Clock::time_point now = Clock::now();
+                double us = std::chrono::duration<double, std::micro>(now - batch->received).count();
+                for (size_t i = 0; i < batch->replies.size(); ++i) {
+                    latencies.push_back(us);
+                    solves.push_back(batch->solveUs[i]);
+                    (batch->searched[i] ? searchSolves : treeSolves).push_back(batch->solveUs[i]);
+                }
+                first = std::min(first, batch->received);
+                last = now;
+            }
+        });
+
+        std::vector<char> buffer(1 << 16);
+        std::string carry;
+        std::shared_ptr<Batch> batch;
+        auto flush = [&]() {
+            if (!batch) return;
+            {
+                std::unique_lock<std::mutex> lock(connection.mutex);
+                connection.changed.wait(lock, [&] { return connection.pending.size() < options.maxInflight; });
+                connection.pending.push_back(batch);
+            }
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                queue.push_back({ &connection, batch });
+            }
+            queueReady.notify_one();
+            batch.reset();
+        };
+        auto addLine = [&](std::string line, Clock::time_point received) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.find_first_not_of(" \t") == std::string::npos) return; // 空行不回复
+            if (!batch) {
+                batch = std::make_shared<Batch>();
+                batch->received = received;
+            }
+            batch->lines.push_back(std::move(line));
+            if (batch->lines.size() == options.batchSize) flush();
+        };
+
+        while (true) {
+            long n = readFd(inFd, buffer.data(), buffer.size());
+            if (n <= 0) break;
+            Clock::time_point received = Clock::now();
+            carry.append(buffer.data(), static_cast<size_t>(n));
+            size_t begin = 0, newline;
+            while ((newline = carry.find('\n', begin)) != std::string::npos) {
+                addLine(carry.substr(begin, newline - begin), received);
+                begin = newline + 1;
+            }
+            carry.erase(0, begin);
+            flush(); // 本次读到的行不等凑满一批，立即提交（交互式使用时不会卡住）
+        }
+        if (!carry.empty()) addLine(carry, Clock::now());
+        flush();
+        {
+            std::lock_guard<std::mutex> lock(connection.mutex);
+            connection.inputClosed = true;
+        }
+        connection.changed.notify_all();
+        writer.join();
+
+        std::lock_guard<std::mutex> lock(statsMutex);
+        allLatencies.insert(allLatencies.end(), latencies.begin(), latencies.end());
+        allSolves.insert(allSolves.end(), solves.begin(), solves.end());
+        treeSolveUs.insert(treeSolveUs.end(), treeSolves.begin(), treeSolves.end());
+        searchSolveUs.insert(searchSolveUs.end(), searchSolves.begin(), searchSolves.end());
+        if (!latencies.empty()) busySeconds += std::chrono::duration<double>(last - first).count();
+    }
+
+    // 关闭时的统计：请求数、吞吐、延迟分位数（收到→写回，以及其中的求解耗时；求解耗时再按是否跑了A*分开，
+    // 两类的分位数相差两个数量级，混在一起时p99只反映两类的比例）
+    void report(std::ostream& out) {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        std::sort(allLatencies.begin(), allLatencies.end());
+        std::sort(allSolves.begin(), allSolves.end());
+        std::sort(treeSolveUs.begin(), treeSolveUs.end());
+        std::sort(searchSolveUs.begin(), searchSolveUs.end());
+        out << "requests=" << requestCount.load() << " nopath=" << noPathCount.load() << " errors=" << errorCount.load()
+            << " busy=" << busySeconds << "s throughput="
+            << (busySeconds > 0.0 ? allLatencies.size() / busySeconds : 0.0) << "qps\n";
+        auto line = [&out](const char* name, const std::vector<double>& sorted) {
+            out << name << " n=" << sorted.size() << " p50=" << percentile(sorted, 0.5) << "us p90=" << percentile(sorted, 0.9)
+                << "us p99=" << percentile(sorted, 0.99) << "us p99.9=" << percentile(sorted, 0.999)
+                << "us max=" << (sorted.empty() ? 0.0 : sorted.back()) << "us\n";
+        };
+        line("latency", allLatencies);
+        line("solve  ", allSolves);
+        line("  tree ", treeSolveUs);
+        line("  astar", searchSolveUs);
+    }
+
+private:
+    void workerLoop() {
+        PathQueryEngine::Scratch scratch;
+        PathQueryResult result;
+        while (true) {
+            std::pair<Connection*, std::shared_ptr<Batch>> item;
+            {
+                std::unique_lock<std::mutex> lock(queueMutex);
+                queueReady.wait(lock, [this] { return stopping || !queue.empty(); });
+                if (queue.empty()) return;
+                item = queue.front();
+                queue.pop_front();
+            }
+            Batch& batch = *item.second;
+            batch.replies.resize(batch.lines.size());
+            batch.solveUs.resize(batch.lines.size());
+            batch.searched.resize(batch.lines.size());
+            for (size_t i = 0; i < batch.lines.size(); ++i) {
+                auto begin = Clock::now();
+                result.expanded = 0;
+                batch.replies[i] = answer(batch.lines[i], scratch, result);
+                batch.solveUs[i] = std::chrono::duration<double, std::micro>(Clock::now() - begin).count();
+                batch.searched[i] = result.expanded > 0;
+            }
+            {
+                std::lock_guard<std::mutex> lock(item.first->mutex);
+                batch.done = true;
+            }
+            item.first->changed.notify_all();
+        }
+    }
+
+    std::string answer(const std::string& line, PathQueryEngine::Scratch& scratch, PathQueryResult& result) {
+        requestCount.fetch_add(1, std::memory_order_relaxed);
+        std::string tokens[8];
+        size_t count = splitTokens(line, tokens, 8);
+        const std::string& id = tokens[0];
+        try {
+            if (count < 6) throw std::runtime_error("Expected: <id> <maze> <row> <col> <row> <col> [algorithm] [lavaBudget]");
+            const PathQueryEngine& engine = findEngine(tokens[1]);
+            Point start = { parseInt(tokens[2], "row"), parseInt(tokens[3], "col") };
+            Point goal = { parseInt(tokens[4], "row"), parseInt(tokens[5], "col") };
+            const bool boundsOnly = count > 6 && tokens[6] == "bounds";
+            const size_t algorithmToken = boundsOnly ? 7 : 6;
+            SearchAlgorithm algorithm = SearchAlgorithm::DIJKSTRA;
+            if (count > algorithmToken) {
+                const std::string& name = tokens[algorithmToken];
+                if (name == "bfs") algorithm = SearchAlgorithm::BFS;
+                else if (name == "dijkstra") algorithm = SearchAlgorithm::DIJKSTRA;
+                else if (name == "lava") algorithm = SearchAlgorithm::LAVA_ONCE;
+                else throw std::runtime_error("Unknown algorithm: " + name);
+            }
+            if (boundsOnly) {
+                DistanceBounds bounds;
+                if (!engine.bounds(algorithm, start, goal, bounds)) {
+                    noPathCount.fetch_add(1, std::memory_order_relaxed);
+                    return id + " nopath";
+                }
+                return id + " bounds " + std::to_string(bounds.lower) + ' '
+                    + (bounds.upper == INT_MAX ? std::string("-") : std::to_string(bounds.upper));
+            }
+            int lavaBudget = count > 7 ? parseInt(tokens[7], "lava budget") : 1;
+            engine.solve(scratch, algorithm, start, goal, lavaBudget, result);
+        }
+        catch (const std::runtime_error& e) {
+            errorCount.fetch_add(1, std::memory_order_relaxed);
+            return (id.empty() ? std::string("?") : id) + " error " + e.what();
+        }
+        if (!result.found) {
+            noPathCount.fetch_add(1, std::memory_order_relaxed);
+            return id + " nopath";
+        }
+        std::string reply = id + " ok " + std::to_string(result.cost) + ' ' + std::to_string(result.lavaSteps)
+            + ' ' + std::to_string(result.path.size());
+        if (options.printPath) {
+            reply.reserve(reply.size() + result.path.size() * 10);
+            for (const Point& p : result.path) {
+                reply += ' ';
+                reply += std::to_string(p.row);
+                reply += ',';
+                reply += std::to_string(p.col);
+            }
+        }
+        return reply;
+    }
+
+    const PathQueryEngine& findEngine(const std::string& token) const {
+        for (size_t i = 0; i < mazeNames.size(); ++i) {
+            if (mazeNames[i] == token) return *engines[i];
+        }
+        char* end = nullptr;
+        long index = std::strtol(token.c_str(), &end, 10);
+        if (!token.empty() && *end == '\0' && index >= 0 && index < static_cast<long>(engines.size())) {
+            return *engines[static_cast<size_t>(index)];
+        }
+        throw std::runtime_error("Unknown maze: " + token);
+    }
+
+    std::vector<std::string> mazeNames;
+    std::vector<std::unique_ptr<PathQueryEngine>> engines;
+    ServerOptions options;
+
+    std::vector<std::thread> workers;
+    std::deque<std::pair<Connection*, std::shared_ptr<Batch>>> queue;  // 待求解的批（受queueMutex保护）
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    bool stopping;
+
+    std::atomic<long long> requestCount;
+    std::atomic<long long> errorCount;
+    std::atomic<long long> noPathCount;
+    std::mutex statsMutex;
+    std::vector<double> allLatencies;   // 微秒
+    std::vector<double> allSolves;
+    std::vector<double> treeSolveUs;    // 未跑A*的查询的求解耗时
+    std::vector<double> searchSolveUs;  // 跑了A*的查询
+    double busySeconds = 0.0;           // 各连接从收到第一个查询到写回最后一个回复的时间之和
+};
+
+#ifndef _WIN32
+// Unix域套接字：每个连接一个读取线程（写出线程由serve创建），共用工作线程池；收到SIGINT/SIGTERM后停止接受，
+// 关闭各连接的读端，等回复写完后返回
+static void serveSocket(QueryServer& server, const std::string& path) {
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) throw std::runtime_error("Failed to create socket");
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) throw std::runtime_error("Socket path too long: " + path);
+    std::strcpy(address.sun_path, path.c_str());
+    unlink(path.c_str());
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listenFd, 16) != 0) {
+        close(listenFd);
+        throw std::runtime_error("Failed to listen on " + path);
+    }
+    std::cerr << "listening on " << path << std::endl;
+
+    std::mutex activeMutex;
+    std::set<int> active;
+    std::map<long long, std::thread> sessions;   // 按会话序号
+    std::vector<long long> finished;             // 已结束、待join的会话（受activeMutex保护）
+    long long nextSession = 0;
+    // 回收已结束的会话线程，长期运行时线程句柄与栈不随累计连接数增长
+    auto reap = [&]() {
+        std::vector<long long> done;
+        {
+            std::lock_guard<std::mutex> lock(activeMutex);
+            done.swap(finished);
+        }
+        for (long long id : done) {
+            auto it = sessions.find(id);
+            it->second.join();
+            sessions.erase(it);
+        }
+    };
+    while (!stopRequested.load()) {
+        reap();
+        pollfd waiting = { listenFd, POLLIN, 0 };
+        if (poll(&waiting, 1, 200) <= 0) continue;
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) continue;
+        {
+            std::lock_guard<std::mutex> lock(activeMutex);
+            active.insert(fd);
+        }
+        const long long id = nextSession++;
+        sessions[id] = std::thread([&server, &activeMutex, &active, &finished, fd, id]() {
+            server.serve(fd, fd);
+            std::lock_guard<std::mutex> lock(activeMutex);
+            active.erase(fd);
+            close(fd);
+            finished.push_back(id);
+        });
+    }
+    close(listenFd);
+    unlink(path.c_str());
+    {
+        std::lock_guard<std::mutex> lock(activeMutex);
+        for (int fd : active) shutdown(fd, SHUT_RD);
+    }
+    for (auto& session : sessions) session.second.join();
+}
+#endif
+
+// 寻路查询服务：常驻加载迷宫，从标准输入（或Unix域套接字）逐行读取查询，多线程求解后按顺序写回；
+// 输入结束（或收到SIGINT/SIGTERM）时在标准错误输出延迟分位数
+// 延迟目标（p99 < 1ms）只对不需要A*的查询类别成立，见QueryServer的说明
+// 用法：MazeServer [--threads N] [--batch N] [--landmarks N] [--no-path] [--socket 路径] 迷宫文件...
+int main(int argc, char* argv[]) {
+    try {
+        ServerOptions options;
+        options.threads = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<std::string> mazeFiles;
+        for (int i = 1; i < argc; ++i) {
+            bool hasValue = i + 1 < argc;
+            if (hasValue && std::strcmp(argv[i], "--threads") == 0) options.threads = std::max(1, std::atoi(argv[++i]));
+            else if (hasValue && std::strcmp(argv[i], "--batch") == 0) options.batchSize = std::max(1, std::atoi(argv[++i]));
+            else if (hasValue && std::strcmp(argv[i], "--socket") == 0) options.socketPath = argv[++i];
+            else if (hasValue && std::strcmp(argv[i], "--landmarks") == 0) options.landmarks = std::max(0, std::atoi(argv[++i]));
+            else if (std::strcmp(argv[i], "--no-path") == 0) options.printPath = false;
+            else mazeFiles.push_back(argv[i]);
+        }
+        if (mazeFiles.empty()) {
+            std::cerr << "usage: MazeServer [--threads N] [--batch N] [--landmarks N] [--no-path] [--socket PATH] <maze>...\n"
+                << "latency: START/END-anchored bfs/dijkstra, bounds and nopath replies need no search (p99 < 1ms);\n"
+                << "         other pairs and lava queries run A* (about 16ms p99 for bfs/dijkstra on a 1001x1001 maze)\n";
+            return -1;
+        }
+
+        // 各迷宫并行加载和预处理
+        auto begin = Clock::now();
+        std::vector<std::future<std::unique_ptr<PathQueryEngine>>> loading;
+        for (const std::string& file : mazeFiles) {
+            const int landmarks = options.landmarks;
+            loading.push_back(std::async(std::launch::async, [file, landmarks]() {
+                Maze maze = MazeParser::loadFromFile(file);
+                return std::unique_ptr<PathQueryEngine>(new PathQueryEngine(maze, landmarks));
+            }));
+        }
+        std::vector<std::unique_ptr<PathQueryEngine>> engines;
+        for (size_t i = 0; i < loading.size(); ++i) {
+            engines.push_back(loading[i].get());
+            const PathQueryEngine& engine = *engines.back();
+            std::cerr << "maze " << i << ": " << mazeFiles[i] << " " << engine.getGrid().getRows() << "x"
+                << engine.getGrid().getCols() << " components=" << engine.getComponentCount()
+                << " landmarks=" << engine.getOracle(SearchAlgorithm::DIJKSTRA).getLandmarkCount()
+                << " preprocess=" << engine.getBuildMs() << "ms\n";
+        }
+        std::cerr << "ready in " << std::chrono::duration<double, std::milli>(Clock::now() - begin).count()
+            << "ms, " << options.threads << " worker threads" << std::endl;
+
+#ifdef _WIN32
+        std::signal(SIGINT, onSignal);
+#else
+        struct sigaction action;
+        std::memset(&action, 0, sizeof(action));
+        action.sa_handler = onSignal;  // 不设SA_RESTART：阻塞的read被打断后按输入结束处理
+        sigaction(SIGINT, &action, nullptr);
+        sigaction(SIGTERM, &action, nullptr);
+        std::signal(SIGPIPE, SIG_IGN);
+#endif
+
+        QueryServer server(mazeFiles, std::move(engines), options);
+        if (options.socketPath.empty()) {
+            server.serve(0, 1);
+        }
+        else {
+#ifdef _WIN32
+            throw std::runtime_error("--socket is not supported on Windows");
+#else
+            serveSocket(server, options.socketPath);
+#endif
+        }
+        server.report(std::cerr);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+    return 0;
+}
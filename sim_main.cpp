@@ -0,0 +1,261 @@
+#include "MazeParser.h"
+#include "GameSession.h"
+#include "InputLog.h"
+#include "PathService.h"
+#include "ResumableSearch.h"
+#include "AllocTracker.h"
+#include "KShortestPaths.h"
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <set>
+
+// 无头回放：按输入日志逐帧推进对局，统计每帧update耗时
+static int replayLog(const std::string& logFile, const std::string& mazeFile) {
+    Maze maze = MazeParser::loadFromFile(mazeFile);
+    InputLog log = InputLog::loadFromFile(logFile);
+    GameSession session(maze);
+
+    double totalMs = 0.0, maxMs = 0.0;
+    FrameAllocCounter allocs;
+    for (size_t i = 0; i < log.size(); ++i) {
+        InputState input = log.inputAt(i);
+        auto begin = std::chrono::steady_clock::now();
+        session.handleInput(input);
+        session.advance(input, log.frame(i).deltaTime);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        totalMs += ms;
+        if (ms > maxMs) maxMs = ms;
+        allocs.beginFrame(); // 结算本帧的分配
+    }
+
+    Point pos = session.getPlayer().getPosition();
+    std::cout << "frames=" << log.size() << " finalState=" << static_cast<int>(session.getState())
+        << " finalTile=(" << pos.row << "," << pos.col << ") lavaSteps=" << session.getPlayer().getLavaStepCount() << "\n";
+    std::cout << "update avg=" << (log.empty() ? 0.0 : totalMs / log.size()) << "ms max=" << maxMs << "ms\n";
+    if (AllocTracker::isHooked()) {
+        std::cout << "allocations: " << allocs.getAllocatingFrames() << " of " << allocs.getFrameCount()
+            << " frames allocated (max " << allocs.getMaxFrameAllocations() << " per frame)\n";
+    }
+    return 0;
+}
+
+// 史莱姆群压力测试：count个NPC追踪终点，统计每个逻辑步的批量更新耗时
+static int runSwarm(int count, const std::string& mazeFile, int steps) {
+    Maze maze = MazeParser::loadFromFile(mazeFile);
+    PathFinder pathFinder(maze);
+    CollisionMap collision(maze);
+    FlowField field;
+    field.build(collision, pathFinder.getEndPoint());
+
+    SlimeSwarm swarm;
+    swarm.spawn(collision, field, count, 42u, 0);
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int step = 0; step < steps; ++step) {
+        swarm.update(collision, field, GameSession::FIXED_STEP);
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    std::cout << "agents=" << swarm.size() << " steps=" << steps << " total=" << ms << "ms"
+        << " perStep=" << ms / steps << "ms perAgent=" << ms * 1e6 / steps / (swarm.size() ? swarm.size() : 1) << "ns\n";
+    return 0;
+}
+
+// 异步寻路压力测试：按60FPS节奏模拟frames帧主循环，每帧为一个agent提交随机起点→终点的查询（取代其旧查询），
+// 并轮询全部句柄；统计主循环一侧的单帧最大耗时和查询完成/取消数
+static int runPathQueries(int agents, const std::string& mazeFile, int frames) {
+    Maze maze = MazeParser::loadFromFile(mazeFile);
+    std::vector<Point> open;
+    for (int row = 0; row < maze.rows; ++row) {
+        for (int col = 0; col < maze.cols; ++col) {
+            if (maze.mapData[row][col] != BlockType::WALL) open.push_back({ row, col });
+        }
+    }
+
+    PathService service(maze, 1);
+    PathFinder pathFinder(maze);
+    std::vector<PathHandle> handles(agents);
+    std::mt19937 rng(7u);
+    double maxFrameMs = 0.0, searchMs = 0.0;
+    long long ready = 0;
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        auto frameBegin = std::chrono::steady_clock::now();
+        int agent = frame % agents;
+        handles[agent] = service.request(agent, open[rng() % open.size()], pathFinder.getEndPoint());
+        for (PathHandle& handle : handles) {
+            if (handle && handle->isDone()) {
+                if (handle->isReady()) {
+                    ++ready;
+                    searchMs += handle->getSearchMs();
+                }
+                handle.reset();
+            }
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameBegin).count();
+        if (ms > maxFrameMs) maxFrameMs = ms;
+        std::this_thread::sleep_until(frameBegin + std::chrono::microseconds(16667));
+    }
+    double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    std::cout << "frames=" << frames << " agents=" << agents << " polledReady=" << ready
+        << " completed=" << service.getCompletedCount() << " cancelled=" << service.getCancelledCount() << "\n";
+    std::cout << "wall=" << totalMs << "ms mainThread maxFrame=" << maxFrameMs << "ms"
+        << " avgSearch=" << (ready ? searchMs / ready : 0.0) << "ms\n";
+    return 0;
+}
+
+// 分帧搜索测试：起点→终点的Dijkstra每帧只推进budgetUs微秒，统计所需帧数、单帧最大耗时，并与一次性搜索对照
+static int runSlicedSearch(double budgetUs, const std::string& mazeFile) {
+    Maze maze = MazeParser::loadFromFile(mazeFile);
+    PathFinder pathFinder(maze);
+    ResumableSearch search(maze, SearchAlgorithm::DIJKSTRA, pathFinder.getStartPoint(), pathFinder.getEndPoint());
+
+    int frames = 0;
+    double maxStepMs = 0.0;
+    size_t partialLength = 0;
+    while (search.getStatus() == ResumableSearch::Status::RUNNING) {
+        auto begin = std::chrono::steady_clock::now();
+        search.step(budgetUs);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        if (ms > maxStepMs) maxStepMs = ms;
+        if (++frames == 1) partialLength = search.getBestPartialPath().size();
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<Point> reference = pathFinder.findShortestPathByDijkstra();
+    double fullMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    std::cout << "budget=" << budgetUs << "us frames=" << frames << " maxStep=" << maxStepMs << "ms"
+        << " expanded=" << search.getExpandedCount() << " firstFramePartial=" << partialLength << "\n";
+    std::cout << "slicedPath=" << search.getPath().size() << " referencePath=" << reference.size()
+        << " referenceSearch=" << fullMs << "ms\n";
+    return 0;
+}
+
+// 备选路线：起点→终点成本最低的count条无环路线（关卡设计检查路线多样性），
+// 输出每条的成本、熔岩格数、长度、分叉位置，以及与最短路线重合的格子比例
+static int runRoutes(int count, const std::string& mazeFile, const std::string& algorithmName, int lavaBudget) {
+    Maze maze = MazeParser::loadFromFile(mazeFile);
+    RouteOptions options;
+    options.count = count;
+    options.lavaBudget = lavaBudget;
+    options.threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    if (algorithmName == "bfs") options.algorithm = SearchAlgorithm::BFS;
+    else if (algorithmName == "lava") options.algorithm = SearchAlgorithm::LAVA_ONCE;
+    else if (algorithmName != "dijkstra") throw std::runtime_error("Unknown algorithm: " + algorithmName);
+
+    PathQueryEngine engine(maze, 0);
+    KShortestPaths finder(engine);
+    std::vector<RankedRoute> routes;
+    finder.find(engine.getStartPoint(), engine.getEndPoint(), options, routes);
+
+    std::set<std::pair<int, int>> shortest;
+    if (!routes.empty()) {
+        for (const Point& p : routes[0].path) shortest.insert({ p.row, p.col });
+    }
+    for (size_t i = 0; i < routes.size(); ++i) {
+        const RankedRoute& route = routes[i];
+        size_t shared = 0;
+        for (const Point& p : route.path) shared += shortest.count({ p.row, p.col });
+        std::cout << "#" << i + 1 << " cost=" << route.cost << " lava=" << route.lavaSteps << " length=" << route.path.size()
+            << " deviation=" << route.deviation << " sharedWithShortest=" << 100.0 * shared / route.path.size() << "%\n";
+    }
+    const KShortestPaths::Stats& stats = finder.getLastStats();
+    std::cout << "routes=" << routes.size() << "/" << count << " tree=" << stats.treeMs << "ms total=" << stats.totalMs << "ms"
+        << " spurSearches=" << stats.spurSearches << " treeJoins=" << stats.treeJoins << " expanded=" << stats.expanded
+        << " peakCandidates=" << stats.peakCandidates << " threads=" << options.threads << "\n";
+    return 0;
+}
+
+// 无头模拟程序：不创建窗口，用随机输入批量跑对局（用于数值平衡和性能基准）
+// 用法：MazeSim [迷宫文件] [对局数] [随机种子] [史莱姆数量]
+//       MazeSim --replay <输入日志> [迷宫文件]
+//       MazeSim --swarm <NPC数量> [迷宫文件] [逻辑步数]
+//       MazeSim --paths <agent数量> [迷宫文件] [帧数]
+//       MazeSim --sliced <每帧预算微秒> [迷宫文件]
+//       MazeSim --routes <路线条数> [迷宫文件] [bfs|dijkstra|lava] [熔岩预算]
+int main(int argc, char* argv[]) {
+    try {
+        if (argc > 2 && std::strcmp(argv[1], "--replay") == 0) {
+            return replayLog(argv[2], argc > 3 ? argv[3] : "./maze0.txt");
+        }
+        if (argc > 2 && std::strcmp(argv[1], "--swarm") == 0) {
+            return runSwarm(std::atoi(argv[2]), argc > 3 ? argv[3] : "./maze0.txt", argc > 4 ? std::atoi(argv[4]) : 1200);
+        }
+
+        if (argc > 2 && std::strcmp(argv[1], "--sliced") == 0) {
+            return runSlicedSearch(std::atof(argv[2]), argc > 3 ? argv[3] : "./maze0.txt");
+        }
+        if (argc > 2 && std::strcmp(argv[1], "--routes") == 0) {
+            return runRoutes(std::atoi(argv[2]), argc > 3 ? argv[3] : "./maze0.txt", argc > 4 ? argv[4] : "dijkstra",
+                argc > 5 ? std::atoi(argv[5]) : 1);
+        }
+        if (argc > 2 && std::strcmp(argv[1], "--paths") == 0) {
+            return runPathQueries(std::max(1, std::atoi(argv[2])), argc > 3 ? argv[3] : "./maze0.txt", argc > 4 ? std::atoi(argv[4]) : 600);
+        }
+
+        const std::string mazeFile = argc > 1 ? argv[1] : "./maze0.txt";
+        const int gameCount = argc > 2 ? std::atoi(argv[2]) : 1000;
+        const unsigned seed = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : 42u;
+        const int slimeCount = argc > 4 ? std::atoi(argv[4]) : 0;
+        const int MAX_FRAMES = 60 * 60;        // 单局最多模拟60秒
+        const int HOLD_FRAMES = 15;            // 随机方向保持的帧数
+        const float DELTA_TIME = 1.0f / 60.0f; // 模拟的显示帧间隔（逻辑按GameSession::FIXED_STEP推进）
+
+        Maze maze = MazeParser::loadFromFile(mazeFile);
+        std::mt19937 rng(seed);
+
+        int wins = 0, gameOvers = 0, caught = 0, timeouts = 0;
+        long long totalFrames = 0;
+        auto begin = std::chrono::steady_clock::now();
+
+        for (int game = 0; game < gameCount; ++game) {
+            GameSession session(maze);
+            session.setSlimes(slimeCount, seed + game);
+            InputState input;
+            input.start = true;
+            session.handleInput(input);
+            input.start = false;
+
+            int frame = 0;
+            for (; frame < MAX_FRAMES && session.getState() == GameState::PLAYING; ++frame) {
+                // 每隔HOLD_FRAMES帧随机换一次方向（0~3：上下左右，4：站立）
+                if (frame % HOLD_FRAMES == 0) {
+                    int dir = static_cast<int>(rng() % 5);
+                    input.up = dir == 0;
+                    input.down = dir == 1;
+                    input.left = dir == 2;
+                    input.right = dir == 3;
+                }
+                session.advance(input, DELTA_TIME);
+            }
+            totalFrames += frame;
+
+            switch (session.getState()) {
+            case GameState::WIN:       ++wins; break;
+            case GameState::GAME_OVER: ++gameOvers; caught += session.isCaughtBySlime() ? 1 : 0; break;
+            default:                   ++timeouts; break;
+            }
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        std::cout << "games=" << gameCount << " win=" << wins << " gameOver=" << gameOvers << " caught=" << caught
+            << " timeout=" << timeouts << " frames=" << totalFrames << "\n";
+        std::cout << "elapsed=" << seconds << "s games/s=" << (seconds > 0 ? gameCount / seconds : 0.0)
+            << " frames/s=" << (seconds > 0 ? totalFrames / seconds : 0.0) << "\n";
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}